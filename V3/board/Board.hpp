@@ -2,6 +2,7 @@
 
 #include "../util/types.hpp"
 #include "../move/MoveList.hpp"
+#include "../init/nnue.hpp"
 #include "impl/temp.hpp"
 #include "Context.hpp"
 #include <string>
@@ -12,6 +13,14 @@ class Board {
     std::array<U64, NUM_BITBOARDS> bitboards; // [Piece]
     BoardArr board;
 
+    // PeSTO accumulators (white - black), kept up to date by set_board.
+    int mg_score   = 0;
+    int eg_score   = 0;
+    int game_phase = 0;
+
+    // NNUE first layer, kept up to date by set_board while NNUE::active.
+    NNUE::Accumulator accumulator;
+
 public:
     Board() {}
 
@@ -23,9 +32,13 @@ public:
     }
 
     template<typename Sq, typename Pc>
-    void set_board(Sq sq, Pc pc) {
-        board.set((int)sq, (Piece)pc);
-    }
+    void set_board(Sq sq, Pc pc);
+
+    int get_mg_score()   { return mg_score; }
+    int get_eg_score()   { return eg_score; }
+    int get_game_phase() { return game_phase; }
+
+    NNUE::Accumulator& get_accumulator();
 
     template<typename Pc>
     U64& get_bitboard(Pc pc) {
@@ -61,24 +74,35 @@ public:
         Move = Move(),
         U16 depth = 0
     );
+    template<class Color, GenType> void gen_legals(MoveList&, Context&);
+    template<class Color> bool is_pseudo_legal(Move, Context&);
+    template<class Color> bool is_legal(Move, Context&);
 
     // do_move.hpp && undo_move.hpp
 
     template<class Color> Context do_move(Move&, Context&);
     template<class Color> void undo_move(Move&);
 
+    // see.hpp
+
+    template<class Color> bool see(Move, int threshold);
+
     // other.hpp
 
     template<class> U64 get_checks();
+    template<class> U64 get_attackers(Square sq, U64 occ);
+    void refresh_accumulator(int persp);
 
 private:
 
     // gen_moves.hpp
 
-    template<class, GenType>   void gen_pawn_moves(MoveList&, Context&, U64 filter);
+    template<class, GenType, bool Legal = false>
+    void gen_pawn_moves(MoveList&, Context&, U64 filter, U64 pawns = ~0ULL);
     template<class, Piece> U64  gen_piece_attacks(Square from_sq);
     template<class, Piece> void _gen_piece_moves(MoveList&, U64 filter, Square from_sq);
-    template<class, Piece> void gen_piece_moves(MoveList&, U64 filter);
+    template<class, Piece> void gen_piece_moves(MoveList&, U64 filter, U64 pieces = ~0ULL);
+    template<class Color> bool is_legal_en_passant(Square from, Square to);
     template<class Color, class Castle> U64 castling_checks();
     template<class Color, class Castle> void gen_castle(MoveList&, Context&);
 
@@ -5,6 +5,8 @@
 struct Context {
     U64 moved;
     U64 hash; // zobrist hash
+    U64 pawn_key; // zobrist hash of the pawns alone (PawnTable index)
+    U64 material_key; // 4-bit count per Piece (MaterialTable index)
     Square en_passant;
 
     Context();
@@ -13,6 +15,9 @@ struct Context {
     void toggle_hash_turn();
     void toggle_hash_piece(Piece, Square);
     void toggle_castling_rights(Square);
+    void add_material(Piece);
+    void remove_material(Piece);
+    int get_count(Piece);
 
     template<class Color> void set_en_passant(Piece, Square from, Square to);
 
@@ -22,6 +27,8 @@ struct Context {
         std::cout << "moved:\n";
         printBB(moved);
         std::cout << "hash: " << std::hex << hash << '\n';
+        std::cout << "pawn_key: " << std::hex << pawn_key << '\n';
+        std::cout << "material_key: " << std::hex << material_key << '\n';
         std::cout << "en_passant: " << std::hex << en_passant << '\n';
     }
 };
\ No newline at end of file
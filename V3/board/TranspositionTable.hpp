@@ -3,26 +3,48 @@
 #include "../util/types.hpp"
 #include "../move/Move.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 struct MoveScore {
     Move move;
     I16 score;
 };
 
+// mate scores count down with distance from the root: a mate found at ply
+// p scores -(MATE_SCORE - p). anything beyond MATE_BOUND is a mate.
+
+constexpr I16 MATE_SCORE = 32000;
+constexpr I16 MATE_BOUND = MATE_SCORE - 1000;
+
 constexpr bool USE_TRANSPOSITION_TABLE = true;
+constexpr bool USE_TT_PREFETCH = true; // fetch a child's bucket before searching it
 
 namespace TranspositionTable {
 
     // Constants
 
-    constexpr size_t IDX_BITS = 20;
-    constexpr U64    IDX_MASK = ((1ULL << IDX_BITS) - 1ULL);
-    constexpr U64    HV_MASK  = ~IDX_MASK;
-    constexpr size_t TT_SIZE  = 1ULL << IDX_BITS;
+    constexpr size_t DEFAULT_MB   = 32;
+    constexpr size_t MAX_MB       = 1ULL << 16;
+    constexpr size_t HUGE_PAGE_SZ = 1ULL << 21; // 2 MB (x86-64 THP)
 
-    // Stats
+    // Stats (per-thread, summed into the totals by flush_stats)
 
-    U64 hits = 0;
-    U64 misses = 0;
+    thread_local U64 hits = 0;
+    thread_local U64 misses = 0;
+
+    std::atomic<U64> total_hits = 0;
+    std::atomic<U64> total_misses = 0;
 
     // Data Structures
 
@@ -32,68 +54,275 @@ namespace TranspositionTable {
         UPPER
     };
 
-    struct Cell {
-        U64 hash_depth; // [ 45-bit hash | 3-bit gap | 16-bit depth ]
+    // decoded copy of a cell, safe to use after other threads overwrite it.
+
+    struct Record {
         Move move;
         I16 score;
+        U16 depth;
         NodeType node_type;
+        I16 eval; // static eval of the position (NO_EVAL in check)
+    };
+
+    constexpr I16 NO_EVAL = -INT16_MAX;
+    constexpr int BUCKET_SIZE = 4;
+    constexpr U8 GEN_MASK = 0b111111;
+
+    // lockless cell: key is stored xor'd with data, so a cell torn by two
+    // racing writers (key from one, data from the other) fails to verify
+    // and reads as a miss instead of handing back a bad move.
+
+    struct Cell {
+        std::atomic<U64> key;  // hash ^ data
+        std::atomic<U64> data; // [ 6-bit gen | 2-bit type | 8-bit depth | 16-bit eval | 16-bit score | 16-bit move ]
+
+        static U64 pack(Move move, I16 score, I16 eval, U16 depth, NodeType node_type, U8 gen) {
+            return ((U64)move.get_masked())
+                 | ((U64)(U16)score << 16)
+                 | ((U64)(U16)eval  << 32)
+                 | ((U64)(U8)depth  << 48)
+                 | ((U64)node_type  << 56)
+                 | ((U64)gen        << 58);
+        }
+
+        static Record unpack(U64 data) {
+            return {
+                Move((U32)(data & Move::MOVE_MASK)),
+                (I16)(U16)(data >> 16),
+                (U16)(U8)(data >> 48),
+                (NodeType)((data >> 56) & 0b11),
+                (I16)(U16)(data >> 32)
+            };
+        }
+
+        bool load(U64 hash, Record& rec) {
+            U64 d = data.load(std::memory_order_relaxed);
+            U64 k = key.load(std::memory_order_relaxed);
+            if ((k ^ d) != hash) return false;
+            rec = unpack(d);
+            return true;
+        }
 
-        U64 get_hash()  { 
-            return hash_depth >> IDX_BITS;
+        void store(U64 hash, U64 d) {
+            key.store(hash ^ d, std::memory_order_relaxed);
+            data.store(d, std::memory_order_relaxed);
         }
-        U16 get_depth() {
-            return (U16)(hash_depth & IDX_MASK);
+
+        U64 get_data() {
+            return data.load(std::memory_order_relaxed);
         }
     };
 
-    struct Entry {
-        Cell rec_cell; // recency_cell
-        Cell dep_cell; // depth_cell
+    // one cache line per bucket: a probe touches a single line, and any of
+    // the 4 cells can hold the position.
+
+    struct alignas(64) Bucket {
+        Cell cells[BUCKET_SIZE];
     };
 
-    Entry table[TT_SIZE] = {};
+    static_assert(sizeof(Bucket) == 64);
+
+    // Table (sized at runtime, power-of-two buckets so indexing is a mask)
+
+    Bucket* table    = nullptr;
+    size_t  tt_size  = 0;
+    U64     idx_mask = 0ULL;
+    U8      generation = 0; // bumped per search, ages out older cells
 
     // Functions
 
-    inline Entry* get_entry(U64 hash) {
-        U64 idx = hash & IDX_MASK;
+    // mates are stored relative to the node (not the root) so a hit at a
+    // different ply still reports the right distance to mate.
+
+    inline I16 score_to_tt(I16 score, U16 ply) {
+        return score >  MATE_BOUND ? score + ply
+             : score < -MATE_BOUND ? score - ply
+             : score;
+    }
+
+    inline I16 score_from_tt(I16 score, U16 ply) {
+        return score >  MATE_BOUND ? score - ply
+             : score < -MATE_BOUND ? score + ply
+             : score;
+    }
+
+    void new_search() {
+        generation = (generation + 1) & GEN_MASK;
+    }
+
+    inline Bucket* get_bucket(U64 hash) {
+        U64 idx = hash & idx_mask;
         return &table[idx];
     }
 
-    inline std::pair<bool, Cell*> get_cell(U64 hash, U16 min_depth) {
+    // start pulling hash's bucket into cache, so the probe at the top of
+    // the child node (made right after the move) doesn't stall on DRAM.
+    inline void prefetch(U64 hash) {
+        if constexpr (!USE_TRANSPOSITION_TABLE || !USE_TT_PREFETCH) return;
+        __builtin_prefetch(get_bucket(hash));
+    }
+
+    // searches since the cell was written (empty cells are maximally old).
+    inline int get_age(U64 data) {
+        return data ? (generation - (U8)(data >> 58)) & GEN_MASK : GEN_MASK;
+    }
+
+    // replacement worth: deep & recent cells are kept, a search worth of
+    // age costs as much as 8 plies of depth.
+    inline int get_worth(U64 data) {
+        return (int)(U8)(data >> 48) - 8 * get_age(data);
+    }
+
+    // on a hit, rec holds the stored record. either way, the returned cell
+    // is the one to pass to set_cell afterwards.
+    inline std::pair<bool, Cell*> get_cell(U64 hash, U16 ply, Record& rec) {
         if constexpr (!USE_TRANSPOSITION_TABLE) return { false, nullptr };
 
-        Entry* entry = get_entry(hash);
-        Cell* rec_cell = &(entry->rec_cell);
-        Cell* dep_cell = &(entry->dep_cell);
-
-        U64 hash_val = hash >> IDX_BITS;
-        // check with depth cell first (optimal accuracy).
-        hits++;
-        if (hash_val == dep_cell->get_hash()) return { true, dep_cell };
-        // check with recency cell second (optimal hitrate).
-        if (hash_val == rec_cell->get_hash()) return { true, rec_cell };
-        // complete miss, return replacement cell.
-        hits--; misses++;
-        Cell* rep_cell = (min_depth >= dep_cell->get_depth()) ? dep_cell : rec_cell;
+        Bucket* bucket = get_bucket(hash);
+
+        for (Cell& cell : bucket->cells) {
+            if (cell.load(hash, rec)) {
+                hits++;
+                rec.score = score_from_tt(rec.score, ply);
+                return { true, &cell };
+            }
+        }
+
+        // complete miss, return the least worth keeping.
+        misses++;
+        Cell* rep_cell = &bucket->cells[0];
+        int rep_worth = get_worth(rep_cell->get_data());
+        for (int i = 1; i < BUCKET_SIZE; i++) {
+            int worth = get_worth(bucket->cells[i].get_data());
+            if (worth < rep_worth) {
+                rep_cell = &bucket->cells[i];
+                rep_worth = worth;
+            }
+        }
         return { false, rep_cell };
     }
 
-    inline void set_cell(Cell* cell, U64 hash, U16 depth, MoveScore ms, I16 og_alpha, I16 beta) {
+    inline void set_cell(Cell* cell, U64 hash, U16 depth, U16 ply, MoveScore ms, I16 og_alpha, I16 beta, I16 eval = NO_EVAL) {
         if constexpr (!USE_TRANSPOSITION_TABLE) return;
 
-        cell->hash_depth = (hash & HV_MASK) | (U64)depth;
-        cell->score = ms.score;
-        cell->move = ms.move;
-        cell->node_type = ms.score <= og_alpha ? NodeType::UPPER
-                        : ms.score >= beta     ? NodeType::LOWER
-                        : NodeType::EXACT;
+        NodeType node_type = ms.score <= og_alpha ? NodeType::UPPER
+                           : ms.score >= beta     ? NodeType::LOWER
+                           : NodeType::EXACT;
+        I16 score = score_to_tt(ms.score, ply);
+        cell->store(hash, Cell::pack(ms.move, score, eval, depth, node_type, generation));
+    }
+
+    // permille of sampled cells written during the current search (uci hashfull).
+    int hashfull() {
+        constexpr size_t SAMPLE = 1000 / BUCKET_SIZE;
+        size_t buckets = std::min(SAMPLE, tt_size);
+        int used = 0;
+        for (size_t i = 0; i < buckets; i++) {
+            for (Cell& cell : table[i].cells) {
+                U64 d = cell.get_data();
+                used += d && get_age(d) == 0;
+            }
+        }
+        return used * 1000 / (int)(buckets * BUCKET_SIZE);
+    }
+
+    void flush_stats() {
+        total_hits += hits;
+        total_misses += misses;
+        hits = 0;
+        misses = 0;
     }
 
     void clear_cells() {
-        for (Entry& entry : table) {
-            entry.dep_cell.hash_depth = 0ULL;
-            entry.rec_cell.hash_depth = 0ULL;
+        std::memset((void*)table, 0, tt_size * sizeof(Bucket));
+        generation = 0;
+    }
+
+    size_t get_bytes() {
+        return tt_size * sizeof(Bucket);
+    }
+
+    // (re)allocate the table at the largest power of two that fits in mb.
+    // on linux, the block is 2 MB aligned and madvise'd for transparent huge
+    // pages, so one TLB entry covers 2 MB of table instead of 4 KB.
+    void resize(size_t mb) {
+        mb = std::max((size_t)1, std::min(mb, MAX_MB));
+        size_t entries = 1;
+        while (entries * 2 * sizeof(Bucket) <= (mb << 20)) entries *= 2;
+
+        if (entries == tt_size) {
+            clear_cells();
+            return;
         }
+
+        // aligned_alloc wants a multiple of the alignment (Hash < 2 MB).
+        size_t bytes = (entries * sizeof(Bucket) + HUGE_PAGE_SZ - 1) & ~(HUGE_PAGE_SZ - 1);
+
+        // allocate first: if that fails, the old table is kept as is.
+#if defined(_WIN32)
+        Bucket* new_table = (Bucket*)_aligned_malloc(bytes, HUGE_PAGE_SZ);
+#else
+        Bucket* new_table = (Bucket*)std::aligned_alloc(HUGE_PAGE_SZ, bytes);
+#endif
+        if (new_table == nullptr) {
+            std::cout << "info string failed to allocate " << mb << " MB hash";
+            if (table == nullptr) {
+                std::cout << "\n";
+                exit(1); // nothing to fall back on
+            }
+            std::cout << ", keeping " << (get_bytes() >> 20) << " MB\n";
+            return;
+        }
+#if defined(_WIN32)
+        _aligned_free(table);
+#else
+        std::free(table);
+#endif
+        table = new_table;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        madvise(table, bytes, MADV_HUGEPAGE);
+#endif
+
+        tt_size  = entries;
+        idx_mask = entries - 1;
+        clear_cells();
+    }
+
+    // bytes of the table currently backed by huge pages (linux only, read
+    // from /proc/self/smaps). 0 if unknown.
+    size_t get_huge_bytes() {
+#if defined(__linux__)
+        std::ifstream smaps("/proc/self/smaps");
+        std::string ln;
+        U64 addr = (U64)table;
+        bool in_range = false;
+        size_t huge_kb = 0;
+
+        while (std::getline(smaps, ln)) {
+            U64 lo, hi; char dash;
+            std::stringstream ss(ln);
+            if (ln.find(':') > ln.find(' ') && (ss >> std::hex >> lo >> dash >> hi) && dash == '-') {
+                in_range = (lo < addr + get_bytes()) && (addr < hi);
+                continue;
+            }
+            if (in_range && ln.rfind("AnonHugePages:", 0) == 0) {
+                huge_kb += std::stoull(ln.substr(14));
+            }
+        }
+        return huge_kb << 10;
+#else
+        return 0;
+#endif
+    }
+
+    void print_info() {
+        size_t bytes = get_bytes();
+        size_t huge  = get_huge_bytes();
+        size_t pages = (bytes - huge) / 4096 + huge / HUGE_PAGE_SZ;
+
+        std::cout << "info string hash " << (bytes >> 20) << " MB"
+                  << " buckets " << tt_size << " x " << BUCKET_SIZE
+                  << " hugepages " << (huge >> 20) << " MB"
+                  << " pages " << pages << " (vs " << (bytes / 4096) << " at 4 KB)\n";
     }
 };
\ No newline at end of file
@@ -18,10 +18,17 @@ Context::Context(void* b_ptr, bool turn, bool castling_rights[4]) {
     this->moved = castling_state;
     this->hash ^= castling_state;
 
+    this->pawn_key = 0ULL;
+    this->material_key = 0ULL;
+
     Board& b = *((Board*)b_ptr);
     for (int i = 0; i < 64; i++) {
         Piece pc = b.get_board(i);
         this->hash ^= ZOBRIST::piece_rands[(int)pc][i];
+        if (pc == Piece::WHITE_PAWN || pc == Piece::BLACK_PAWN) {
+            this->pawn_key ^= ZOBRIST::piece_rands[(int)pc][i];
+        }
+        this->add_material(pc);
     }
 }
 
@@ -31,8 +38,32 @@ void Context::toggle_hash_turn() {
     hash ^= ZOBRIST::turn_rand;
 }
 
+// every pawn add/remove in do_move comes through here, so the pawn key
+// follows along (branchless: masked to 0 for non-pawns).
 void Context::toggle_hash_piece(Piece pc, Square sq) {
-    hash ^= ZOBRIST::piece_rands[(int)pc][(int)sq];
+    U64 rand = ZOBRIST::piece_rands[(int)pc][(int)sq];
+    U64 is_pawn = (pc == Piece::WHITE_PAWN) | (pc == Piece::BLACK_PAWN);
+    hash ^= rand;
+    pawn_key ^= rand & (0ULL - is_pawn);
+}
+
+// material key: piece pc's count sits in bits [4 * pc, 4 * pc + 4).
+// NA (no capture) adds nothing, so callers needn't branch on it.
+
+constexpr U64 material_unit(Piece pc) {
+    return (int)pc < 12 ? 1ULL << (4 * (int)pc) : 0ULL;
+}
+
+void Context::add_material(Piece pc) {
+    material_key += material_unit(pc);
+}
+
+void Context::remove_material(Piece pc) {
+    material_key -= material_unit(pc);
+}
+
+int Context::get_count(Piece pc) {
+    return (int)((material_key >> (4 * (int)pc)) & 0b1111);
 }
 
 void Context::toggle_castling_rights(Square sq) {
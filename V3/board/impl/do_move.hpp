@@ -16,6 +16,7 @@ void inline Board::remove_piece(Square sq, Piece pc, Piece pc_col_all) {
 template<class Color>
 void inline Board::remove_piece(Context& ctx, Square sq, Piece pc, Piece pc_col_all) {
     ctx.toggle_hash_piece(pc, sq);
+    ctx.remove_material(pc);
     this->remove_piece<Color>(sq, pc, pc_col_all);
 }
 
@@ -31,6 +32,7 @@ void inline Board::add_piece(Square sq, Piece pc, Piece pc_col_all) {
 template<class Color>
 void inline Board::add_piece(Context& ctx, Square sq, Piece pc, Piece pc_col_all) {
     ctx.toggle_hash_piece(pc, sq);
+    ctx.add_material(pc);
     this->remove_piece<Color>(sq, pc, pc_col_all);
 }
 
@@ -54,6 +56,7 @@ void inline Board::move_piece(Context& ctx, Piece pc, Square from, Square to) {
 template<class Color>
 void inline Board::do_regular(Context& ctx, Piece pc, Piece capt, Square from, Square to) {
     ctx.toggle_hash_piece(capt, to);
+    ctx.remove_material(capt);
     U64 to_bit = 1ULL << to;
     this->bitboards[(int)capt]           &= ~to_bit;
     this->bitboards[(int)Color::OPP_ALL] &= ~to_bit;
@@ -89,11 +92,14 @@ void inline Board::do_promo(Context& ctx, Flag fg, Piece capt, Square from, Squa
     U64 bit_diff = from_bit | to_bit;
 
     ctx.toggle_hash_piece(capt, to);
+    ctx.remove_material(capt);
     this->bitboards[(int)capt]           &= ~to_bit;
     this->bitboards[(int)Color::OPP_ALL] &= ~to_bit;
 
     ctx.toggle_hash_piece(promo_piece, to);
     ctx.toggle_hash_piece((Piece)Color::PAWN, from);
+    ctx.add_material(promo_piece);
+    ctx.remove_material((Piece)Color::PAWN);
 
     this->set_board(from, Piece::NA);
     this->set_board(to,   promo_piece);
@@ -6,22 +6,27 @@
 #include "context.hpp"
 
 // PAWNS: singles, doubles, promos, captures, promo-captures
+// (pawns: the subset to generate for, filter: allowed destinations)
 
-template<class Color, GenType Gn>
-void Board::gen_pawn_moves(MoveList &moves, Context& ctx, U64 filter) {
+template<class Color, GenType Gn, bool Legal>
+void Board::gen_pawn_moves(MoveList &moves, Context& ctx, U64 filter, U64 pawns) {
     if (Gn == GenType::PSEUDOS) {
-        gen_pawn_moves<Color, GenType::CAPTURES>(moves, ctx, this->get_bitboard(Color::OPP_ALL));
-        gen_pawn_moves<Color, GenType::QUIETS  >(moves, ctx, this->get_unocc());
+        gen_pawn_moves<Color, GenType::CAPTURES, Legal>(moves, ctx, filter & this->get_bitboard(Color::OPP_ALL), pawns);
+        gen_pawn_moves<Color, GenType::QUIETS,   Legal>(moves, ctx, filter & this->get_unocc(), pawns);
         return;
     }
 
-    U64 promo_pawns = this->bitboards[Color::PAWN] & Color::PAWN_FINAL_RANK;
-    U64 reg_pawns   = this->bitboards[Color::PAWN] & ~Color::PAWN_FINAL_RANK;
+    U64 promo_pawns = this->bitboards[Color::PAWN] & pawns & Color::PAWN_FINAL_RANK;
+    U64 reg_pawns   = this->bitboards[Color::PAWN] & pawns & ~Color::PAWN_FINAL_RANK;
 
     if constexpr (Gn == GenType::QUIETS || Gn == GenType::BLOCKS) {
-        U64 singles = shift<Color::FORWARD>(reg_pawns)   & filter;
+        // a double push only needs its landing square in filter (it can
+        // block a check its single push can't).
+        U64 unocc   = this->get_unocc();
+        U64 singles = shift<Color::FORWARD>(reg_pawns)   & unocc;
         U64 doubles = shift<Color::FORWARD>(singles)     & filter & Color::PAWN_DOUBLE_RANK; 
         U64 promos  = shift<Color::FORWARD>(promo_pawns) & filter;
+        singles &= filter;
 
         while (singles) {
             Square to = pop_lsb(singles);
@@ -81,6 +86,9 @@ void Board::gen_pawn_moves(MoveList &moves, Context& ctx, U64 filter) {
             while (attackers) {
                 U64 from = pop_lsb(attackers);
                 U64 to = ctx.en_passant;
+                if constexpr (Legal) {
+                    if (!this->is_legal_en_passant<Color>(from, to)) continue;
+                }
                 moves.add(Move::make<Flag::EN_PASSANT>(from, to));
             }
         }
@@ -111,8 +119,8 @@ void Board::_gen_piece_moves(MoveList &moves, U64 filter, Square from_sq) {
 }
 
 template<class Color, Piece Pc>
-void Board::gen_piece_moves(MoveList &moves, U64 filter) {
-    U64 from_bb = this->get_bitboard(Pc);
+void Board::gen_piece_moves(MoveList &moves, U64 filter, U64 pieces) {
+    U64 from_bb = this->get_bitboard(Pc) & pieces;
 
     if constexpr (Pc == (Piece)Color::KING) {
         Square from_sq = lsb(from_bb);
@@ -140,10 +148,82 @@ void Board::gen_castle(MoveList& moves, Context& ctx) {
     moves.add_castle<Castle>(can_castle);
 }
 
+// LEGALS: pseudo generation restricted by the position's checks & pins, so
+// nothing has to be made and unmade to find out it was illegal.
+//      1. King      -> destinations not attacked once the king has moved
+//      2. Checks    -> double: king only. single: capture or block the checker
+//      3. Pins      -> pinned pieces stay on their king ray (BITS_RAY)
+//      4. EP        -> simulated (both pawns leave the rank), see below
+//      5. Castles   -> already fully checked by gen_castle
+
+template<class Color>
+bool Board::is_legal_en_passant(Square from, Square to) {
+    Square king = lsb(this->get_bitboard(Color::KING));
+    U64 capt_bit = 1ULL << (to - Color::FORWARD);
+    U64 occ = (this->get_occ() ^ (1ULL << from) ^ capt_bit) | (1ULL << to);
+    return (this->get_attackers<Color>(king, occ) & ~capt_bit) == 0ULL;
+}
+
+template<class Color, GenType Gn>
+void Board::gen_legals(MoveList& moves, Context& ctx) {
+    U64 filter = Gn == GenType::CAPTURES ? this->get_bitboard(Color::OPP_ALL)
+               : Gn == GenType::QUIETS   ? this->get_unocc()
+               : ~this->get_bitboard(Color::ALL);
+
+    Square king = lsb(this->get_bitboard(Color::KING));
+    U64 checks = this->get_checks<Color>();
+
+    // king: sliders have to see through it (no stepping back along a check).
+    U64 occ_wo_king = this->get_occ() ^ (1ULL << king);
+    U64 king_to = MAPPED_MOVES::get_k_attacks(king) & filter;
+    while (king_to) {
+        Square to = pop_lsb(king_to);
+        if (this->get_attackers<Color>(to, occ_wo_king) == 0ULL) {
+            moves.add(Move::make<Flag::REGULAR>(king, to));
+        }
+    }
+    if (pop_count(checks) > 1) return;
+
+    U64 targets = checks ? filter & this->get_check_blocks<Color>(checks) : filter;
+    U64 pins = this->get_pins<Color>();
+
+    // free pieces
+
+    this->gen_pawn_moves <Color, Gn, true>(moves, ctx, targets, ~pins);
+    this->gen_piece_moves<Color, (Piece)Color::KNIGHT>(moves, targets, ~pins);
+    this->gen_piece_moves<Color, (Piece)Color::BISHOP>(moves, targets, ~pins);
+    this->gen_piece_moves<Color, (Piece)Color::ROOK  >(moves, targets, ~pins);
+    this->gen_piece_moves<Color, (Piece)Color::QUEEN >(moves, targets, ~pins);
+
+    // pinned pieces (a pinned knight never moves)
+
+    while (pins) {
+        Square from = pop_lsb(pins);
+        U64 ray_targets = targets & MAPPED_MOVES::BITS_RAY[king][from];
+        Piece pc = this->get_board(from);
+        if (pc == (Piece)Color::PAWN)   this->gen_pawn_moves<Color, Gn, true>(moves, ctx, ray_targets, 1ULL << from);
+        if (pc == (Piece)Color::BISHOP) this->_gen_piece_moves<Color, (Piece)Color::BISHOP>(moves, ray_targets, from);
+        if (pc == (Piece)Color::ROOK)   this->_gen_piece_moves<Color, (Piece)Color::ROOK  >(moves, ray_targets, from);
+        if (pc == (Piece)Color::QUEEN)  this->_gen_piece_moves<Color, (Piece)Color::QUEEN >(moves, ray_targets, from);
+    }
+
+    if constexpr (Gn == GenType::QUIETS || Gn == GenType::PSEUDOS) {
+        if (checks == 0ULL) {
+            this->gen_castle<Color, typename Color::OO >(moves, ctx);
+            this->gen_castle<Color, typename Color::OOO>(moves, ctx);
+        }
+    }
+}
+
 // GENS
 
 template<class Color, GenType Gn>
 void Board::gen_moves(MoveList& moves, Context& ctx) {
+    if constexpr (Gn == GenType::LEGALS) {
+        this->gen_legals<Color, GenType::PSEUDOS>(moves, ctx);
+        return;
+    }
+
     U64 filter = Gn == GenType::CAPTURES ? this->get_bitboard(Color::OPP_ALL)
                : Gn == GenType::QUIETS   ? this->get_unocc()
                : Gn == GenType::PSEUDOS  ? ~this->get_bitboard(Color::ALL)
@@ -165,6 +245,77 @@ void Board::gen_moves(MoveList& moves, Context& ctx) {
     }
 }
 
+// TT / killer moves are tried before anything is generated, so they have to
+// be checked against the position first (hash collisions, sibling killers).
+
+template<class Color>
+bool Board::is_pseudo_legal(Move m, Context& ctx) {
+    Square from = m.get_from();
+    Square to   = m.get_to();
+    Flag   flag = m.get_flag();
+    Piece  pc   = this->get_board(from);
+    U64 to_bit  = 1ULL << to;
+
+    bool is_own = ((int)pc >= (int)Color::PAWN) & ((int)pc <= (int)Color::KING);
+    if (!is_own || (this->get_bitboard(Color::ALL) & to_bit)) return false;
+
+    if (flag == Flag::CASTLE) {
+        if (pc != (Piece)Color::KING || this->get_checks<Color>()) return false;
+        MoveList ml;
+        if (from == Color::OO::KING_PRE  && to == Color::OO::KING_POST ) this->gen_castle<Color, typename Color::OO >(ml, ctx);
+        if (from == Color::OOO::KING_PRE && to == Color::OOO::KING_POST) this->gen_castle<Color, typename Color::OOO>(ml, ctx);
+        return ml.size() > 0;
+    }
+
+    if (pc == (Piece)Color::PAWN) {
+        if (flag == Flag::EN_PASSANT) {
+            return (ctx.en_passant != 0) & (to == ctx.en_passant)
+                 & ((Color::PAWN_ATTACKS[from] & to_bit) != 0ULL);
+        }
+
+        bool on_promo_rank = ((1ULL << from) & Color::PAWN_FINAL_RANK) != 0ULL;
+        if (on_promo_rank != (flag >= Flag::KNIGHT_PROMO)) return false;
+
+        U64 unocc  = this->get_unocc();
+        U64 single = shift<Color::FORWARD>(1ULL << from) & unocc;
+        U64 doubles = shift<Color::FORWARD>(single) & unocc & Color::PAWN_DOUBLE_RANK;
+        U64 caps   = Color::PAWN_ATTACKS[from] & this->get_bitboard(Color::OPP_ALL);
+        return ((single | doubles | caps) & to_bit) != 0ULL;
+    }
+
+    if (flag != Flag::REGULAR) return false;
+
+    U64 attacks = pc == (Piece)Color::KNIGHT ? this->gen_piece_attacks<Color, (Piece)Color::KNIGHT>(from)
+                : pc == (Piece)Color::BISHOP ? this->gen_piece_attacks<Color, (Piece)Color::BISHOP>(from)
+                : pc == (Piece)Color::ROOK   ? this->gen_piece_attacks<Color, (Piece)Color::ROOK  >(from)
+                : pc == (Piece)Color::QUEEN  ? this->gen_piece_attacks<Color, (Piece)Color::QUEEN >(from)
+                :                              this->gen_piece_attacks<Color, (Piece)Color::KING  >(from);
+    return (attacks & to_bit) != 0ULL;
+}
+
+template<class Color>
+bool Board::is_legal(Move m, Context& ctx) {
+    if (!this->is_pseudo_legal<Color>(m, ctx)) return false;
+
+    Square from = m.get_from();
+    Square to   = m.get_to();
+    Flag   flag = m.get_flag();
+    Square king = lsb(this->get_bitboard(Color::KING));
+
+    if (flag == Flag::CASTLE)     return true; // gen_castle checked the path
+    if (flag == Flag::EN_PASSANT) return this->is_legal_en_passant<Color>(from, to);
+    if (from == king) {
+        return this->get_attackers<Color>(to, this->get_occ() ^ (1ULL << king)) == 0ULL;
+    }
+
+    U64 checks = this->get_checks<Color>();
+    if (pop_count(checks) > 1) return false;
+    if (checks && !(this->get_check_blocks<Color>(checks) & (1ULL << to))) return false;
+
+    bool is_pinned = (this->get_pins<Color>() & (1ULL << from)) != 0ULL;
+    return !is_pinned || (MAPPED_MOVES::BITS_RAY[king][from] & (1ULL << to));
+}
+
 template<class Color, GenType Gn>
 void Board::gen_order_moves(
     MoveList& ml,
@@ -3,6 +3,7 @@
 #include "do_move.hpp"
 #include "undo_move.hpp"
 #include "other.hpp"
+#include "see.hpp"
 #include "gen_moves.hpp"
 #include "interface.hpp"
 #include "context.hpp"
\ No newline at end of file
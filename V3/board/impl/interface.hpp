@@ -5,8 +5,12 @@
 #include "../../util/assertion.hpp"
 #include "../../search/impl/index.hpp"
 #include "../../search/DrawTable.hpp"
+#include "../../tests/perft.hpp"
+#include "../../tests/tt_stress.hpp"
+#include "../../tests/eval_bench.hpp"
 #include "context.hpp"
 
+#include <charconv>
 #include <cstdio>
 #include <iostream>
 #include <string>
@@ -18,9 +22,6 @@
 #define MAX_FEN_EN_PASSANT_LENGTH 2
 
 Context Board::from_fen(std::string fen_str, bool& turn) {
-    TranspositionTable::clear_cells();
-    KillerTable::clear_cells();
-
     if (fen_str.compare("startpos") == 0) {
         fen_str = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
     }
@@ -53,8 +54,10 @@ Context Board::from_fen(std::string fen_str, bool& turn) {
 
     // Init board & bitboards
 
-    for (int i = 0; i < 64; i++) this->set_board(i, Piece::NA);
+    for (int i = 0; i < 64; i++) this->board.set(i, Piece::NA);
     for (U64 &x : bitboards) x = 0ULL;
+    mg_score = eg_score = game_phase = 0;
+    accumulator.dirty[0] = accumulator.dirty[1] = true;
 
     // Set board & bitboards
 
@@ -162,8 +165,8 @@ void play_moves(
         );
 
         MoveList ml = MoveList();
-        if (turn) b.gen_order_moves<White, GenType::PSEUDOS>(ml, ctx);
-             else b.gen_order_moves<Black, GenType::PSEUDOS>(ml, ctx);
+        if (turn) b.gen_order_moves<White, GenType::LEGALS>(ml, ctx);
+             else b.gen_order_moves<Black, GenType::LEGALS>(ml, ctx);
 
         U8 from = string_to_square_num(s[0], s[1]);
         U8 to   = string_to_square_num(s[2], s[3]);
@@ -204,12 +207,84 @@ void play_best_move(
     bool& turn,
     Move& best_move
 ) {
-    std::cout << "bestmove " << best_move.to_string() << "\n";
+    std::cout << "bestmove " << best_move.to_string();
+    if (Search::ponder_move.get_raw()) {
+        std::cout << " ponder " << Search::ponder_move.to_string();
+    }
+    std::cout << "\n";
     if (turn) ctx = b.do_move<White>(best_move, ctx);
          else ctx = b.do_move<Black>(best_move, ctx);
     turn = !turn;
 }
 
+void print_options() {
+    std::cout << "option name Threads type spin default 1 min 1 max " << Search::MAX_THREADS << "\n";
+    std::cout << "option name Hash type spin default " << TranspositionTable::DEFAULT_MB
+              << " min 1 max " << TranspositionTable::MAX_MB << "\n";
+    std::cout << "option name EvalFile type string default <empty>\n";
+    std::cout << "option name UseNNUE type check default false\n";
+    std::cout << "option name RFPMargin type spin default " << Search::rfp_margin << " min 0 max 1000\n";
+    std::cout << "option name RazorMargin type spin default " << Search::razor_margin << " min 0 max 1000\n";
+    std::cout << "option name FutilityMargin type spin default " << Search::futility_margin << " min 0 max 1000\n";
+}
+
+// spin values: a malformed number is reported and ignored instead of
+// throwing out of the uci loop. in-range otherwise, like the gui's limits.
+bool parse_spin(std::string& name, std::string& value, int lo, int hi, int& out) {
+    long long v;
+    const char* end = value.data() + value.size();
+    auto [ ptr, ec ] = std::from_chars(value.data(), end, v);
+    if (ec != std::errc() || ptr != end) {
+        std::cout << "info string invalid value '" << value << "' for " << name << "\n";
+        return false;
+    }
+    out = (int)std::clamp(v, (long long)lo, (long long)hi);
+    return true;
+}
+
+void set_option(std::string ln) {
+    std::stringstream ss(ln);
+    std::string tok, name, value;
+
+    ss >> tok; // "name"
+    while (ss >> tok && tok.compare("value") != 0) {
+        name += (name.empty() ? "" : " ") + tok;
+    }
+    ss >> value;
+
+    int spin;
+    if (name.compare("Threads") == 0 && parse_spin(name, value, 1, Search::MAX_THREADS, spin)) {
+        Search::num_threads = (U16)spin;
+    }
+    if (name.compare("Hash") == 0 && parse_spin(name, value, 1, TranspositionTable::MAX_MB, spin)) {
+        TranspositionTable::resize(spin);
+        TranspositionTable::print_info();
+    }
+    if (name.compare("EvalFile") == 0) {
+        // a new net under an active backend: cached evals are the old net's.
+        if (NNUE::load(value) && NNUE::active) Search::clear();
+    }
+    if (name.compare("UseNNUE") == 0) {
+        bool use_nnue = value.compare("true") == 0;
+        if (use_nnue && !NNUE::loaded) {
+            std::cout << "info string no network loaded, set EvalFile first\n";
+        }
+        bool was_active = NNUE::active;
+        NNUE::active = use_nnue && NNUE::loaded;
+        // TT & eval cache entries hold the other backend's static evals.
+        if (NNUE::active != was_active) Search::clear();
+    }
+    if (name.compare("RFPMargin") == 0 && parse_spin(name, value, 0, 1000, spin)) {
+        Search::rfp_margin = spin;
+    }
+    if (name.compare("RazorMargin") == 0 && parse_spin(name, value, 0, 1000, spin)) {
+        Search::razor_margin = spin;
+    }
+    if (name.compare("FutilityMargin") == 0 && parse_spin(name, value, 0, 1000, spin)) {
+        Search::futility_margin = spin;
+    }
+}
+
 void CLI() {
     Board b;
     Context ctx;
@@ -222,6 +297,7 @@ void CLI() {
         if (s.compare("uci") == 0) {
             std::cout << "id name " << "MyChess" << "\n";
             std::cout << "id author " << "Arnav" << "\n";
+            print_options();
             std::cout << "uciok\n";
             continue;
         }
@@ -234,14 +310,16 @@ void CLI() {
             continue;
         }
         if (s.compare("setoption") == 0) {
-            std::string ln; std::getline(std::cin, ln); // eat args
-            continue; // NOT HANDLED
+            std::string ln; std::getline(std::cin, ln);
+            set_option(ln);
+            continue;
         }
         if (s.compare("register") == 0) {
             std::string ln; std::getline(std::cin, ln); // eat args
             continue; // NOT HANDLED
         }
         if (s.compare("ucinewgame") == 0) {
+            Search::clear();
             ctx = b.from_fen("startpos", turn);
             continue; // NOT HANDLED/IGNOREABLE
         }
@@ -310,6 +388,70 @@ void CLI() {
         if (s.compare("quit") == 0) {
             exit(0);
         }
+        if (s.compare("bench") == 0) { // bench [depth] [threads] [hash]
+            std::string ln; std::getline(std::cin, ln);
+            std::stringstream ss(ln);
+
+            int depth = 9, threads = 1;
+            size_t hash_mb = TranspositionTable::DEFAULT_MB; // same signature as main's bench
+            ss >> depth >> threads >> hash_mb;
+
+            Search::bench(depth, threads, hash_mb);
+            continue;
+        }
+        if (s.compare("perft") == 0) { // perft [depth] [divide] [solution_file]
+            std::string ln; std::getline(std::cin, ln);
+            std::stringstream ss(ln);
+
+            int depth = 5;
+            std::string tok, solution_file;
+            ss >> depth;
+            Perft::print_divide = false;
+            while (ss >> tok) {
+                if (tok.compare("divide") == 0) Perft::print_divide = true;
+                else solution_file = tok;
+            }
+
+            Perft::num_threads = Search::num_threads;
+            if (turn) Perft::run<White>(b, ctx, std::clamp(depth, 1, (int)MAX_DEPTH), solution_file);
+                 else Perft::run<Black>(b, ctx, std::clamp(depth, 1, (int)MAX_DEPTH), solution_file);
+            Perft::print_divide = false;
+            continue;
+        }
+        if (s.compare("perftsuite") == 0) { // perftsuite [epd] [max_depth] [hash_mb]
+            std::string ln; std::getline(std::cin, ln);
+            std::stringstream ss(ln);
+
+            std::string fname = "tests/perft_suite.epd";
+            int max_depth = 5;
+            U64 hash_mb = 0;
+            ss >> fname >> max_depth >> hash_mb;
+
+            Perft::num_threads = Search::num_threads;
+            Perft::run_suite(fname, max_depth, hash_mb);
+            continue;
+        }
+        if (s.compare("evalbench") == 0) { // evalbench [depth] (pestos vs nnue evals/s)
+            std::string ln; std::getline(std::cin, ln);
+            std::stringstream ss(ln);
+
+            int depth = 3;
+            ss >> depth;
+
+            std::vector<std::string> fens(std::begin(Search::BENCH_FENS), std::end(Search::BENCH_FENS));
+            EvalBench::run(fens, std::clamp(depth, 0, 5));
+            continue;
+        }
+        if (s.compare("ttstress") == 0) { // ttstress [threads] (clears the TT)
+            std::string ln; std::getline(std::cin, ln);
+            std::stringstream ss(ln);
+
+            int threads = 16;
+            ss >> threads;
+
+            TTStress::run(std::clamp(threads, 1, (int)Search::MAX_THREADS));
+            continue;
+        }
         if (s.compare("print") == 0) {
             std::string type; std::cin >> type;
             if (type.compare("board") == 0) {
@@ -323,8 +465,8 @@ void CLI() {
             }
             if (type.compare("movelist") == 0) {
                 MoveList ml;
-                if (turn) b.gen_order_moves<White, GenType::PSEUDOS>(ml, ctx);
-                     else b.gen_order_moves<Black, GenType::PSEUDOS>(ml, ctx);
+                if (turn) b.gen_order_moves<White, GenType::LEGALS>(ml, ctx);
+                     else b.gen_order_moves<Black, GenType::LEGALS>(ml, ctx);
                 
                 ml.print();
             }
@@ -4,6 +4,66 @@
 #include "../../init/init.hpp"
 #include "../../util/conversion.hpp"
 
+// every square write goes through here, so the PeSTO accumulators are
+// updated incrementally by do_move/undo_move (captures included: the
+// piece being overwritten is subtracted).
+template<typename Sq, typename Pc>
+void inline Board::set_board(Sq sq, Pc pc) {
+    int old = (int)board.get((int)sq);
+    int pc_idx = (int)pc;
+    this->mg_score   += PeSTOs::mg_incr[pc_idx][(int)sq] - PeSTOs::mg_incr[old][(int)sq];
+    this->eg_score   += PeSTOs::eg_incr[pc_idx][(int)sq] - PeSTOs::eg_incr[old][(int)sq];
+    this->game_phase += PeSTOs::phase_incr[pc_idx] - PeSTOs::phase_incr[old];
+    board.set((int)sq, (Piece)pc);
+
+    if (!NNUE::active) {
+        accumulator.dirty[0] = accumulator.dirty[1] = true;
+        return;
+    }
+
+    // a king move invalidates its own side's features (all keyed on it);
+    // that side is rebuilt lazily at the next eval. kings aren't features.
+    constexpr int KINGS[2] = { (int)Piece::WHITE_KING, (int)Piece::BLACK_KING };
+    bool old_feature = (old != (int)Piece::NA) & (old != KINGS[0]) & (old != KINGS[1]);
+    bool new_feature = (pc_idx != (int)Piece::NA) & (pc_idx != KINGS[0]) & (pc_idx != KINGS[1]);
+
+    for (int persp = 0; persp < 2; persp++) {
+        if ((old == KINGS[persp]) | (pc_idx == KINGS[persp])) {
+            accumulator.dirty[persp] = true;
+        }
+        if (accumulator.dirty[persp]) continue;
+
+        Square king_sq = lsb(bitboards[KINGS[persp]]);
+        if (old_feature) {
+            NNUE::sub_feature(accumulator.values[persp], NNUE::feature_index(persp, king_sq, (Piece)old, (Square)sq));
+        }
+        if (new_feature) {
+            NNUE::add_feature(accumulator.values[persp], NNUE::feature_index(persp, king_sq, (Piece)pc_idx, (Square)sq));
+        }
+    }
+}
+
+void Board::refresh_accumulator(int persp) {
+    Square king_sq = lsb(bitboards[persp ? (int)Piece::BLACK_KING : (int)Piece::WHITE_KING]);
+    I16* acc = accumulator.values[persp];
+    NNUE::reset(acc);
+
+    U64 pieces = this->get_occ()
+               & ~bitboards[(int)Piece::WHITE_KING]
+               & ~bitboards[(int)Piece::BLACK_KING];
+    while (pieces) {
+        Square sq = pop_lsb(pieces);
+        NNUE::add_feature(acc, NNUE::feature_index(persp, king_sq, this->get_board(sq), sq));
+    }
+    accumulator.dirty[persp] = false;
+}
+
+NNUE::Accumulator& Board::get_accumulator() {
+    if (accumulator.dirty[0]) refresh_accumulator(0);
+    if (accumulator.dirty[1]) refresh_accumulator(1);
+    return accumulator;
+}
+
 template<class Color, class Castle>
 U64 Board::castling_checks() {
     U64 occ_wo_king = this->get_occ() & ~this->bitboards[(int)Color::KING];
@@ -27,12 +87,9 @@ U64 Board::castling_checks() {
          | bishop_attackers | rook_attackers | queen_attackers;
 }
 
+// opponent pieces attacking sq, with sliders seeing through occ.
 template<class Color>
-U64 Board::get_checks() {
-    U64 occ = this->get_occ();
-        
-    Square sq = lsb(this->get_bitboard(Color::KING));
-
+U64 Board::get_attackers(Square sq, U64 occ) {
     U64 pawn_risks   = Color::PAWN_ATTACKS[sq];
     U64 knight_risks = MAPPED_MOVES::KNIGHT_MOVES[sq];
     U64 rook_risks   = KMAGICS::get_r_attacks(sq, occ);
@@ -51,6 +108,12 @@ U64 Board::get_checks() {
          | knight_attackers | pawn_attackers | king_attackers;
 }
 
+template<class Color>
+U64 Board::get_checks() {
+    Square sq = lsb(this->get_bitboard(Color::KING));
+    return this->get_attackers<Color>(sq, this->get_occ());
+}
+
 template<class Color>
 U64 Board::get_pins() {
     Square sq = lsb(this->get_bitboard(Color::KING));
@@ -174,6 +237,12 @@ void Board::assert_board_consistency() {
         assert(name, this->get_board(sq) == Piece::NA);
     }
 
+    // incremental eval vs. full scan.
+    assert(
+        "PESTO ACCUMULATORS",
+        PeSTOs::eval(*this) == PeSTOs::eval_full(*this)
+    );
+
     // OTHER
 
     // accidental piece creation.
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../Board.hpp"
+#include "../../init/init.hpp"
+
+// Static Exchange Evaluation: plays out every capture on the move's target
+// square, least valuable attacker first, and checks the result against a
+// threshold. Sliders behind a capturer join in as it leaves (x-rays).
+// Non-regular moves (castles, promos, en passant) are treated as even.
+
+constexpr int SEE_VALS[16] = {
+    82, 337, 365, 477, 1025, 0, // (PeSTO midgame values, king = 0)
+    82, 337, 365, 477, 1025, 0,
+    0, 0, 0, 0
+};
+
+template<class Color>
+bool Board::see(Move m, int threshold) {
+    if (m.get_flag() != Flag::REGULAR) return 0 >= threshold;
+
+    Square from = m.get_from();
+    Square to   = m.get_to();
+
+    // best case: the victim is won for free.
+    int swap = SEE_VALS[(int)this->get_board(to)] - threshold;
+    if (swap < 0) return false;
+
+    // worst case: the capturer is lost for nothing.
+    swap = SEE_VALS[(int)this->get_board(from)] - swap;
+    if (swap <= 0) return true;
+
+    U64 occ = this->get_occ() ^ (1ULL << from) ^ (1ULL << to);
+    U64 attackers = (this->get_attackers<White>(to, occ) | this->get_attackers<Black>(to, occ)) & occ;
+
+    U64 diag = this->bitboards[(int)Piece::WHITE_BISHOP] | this->bitboards[(int)Piece::BLACK_BISHOP]
+             | this->bitboards[(int)Piece::WHITE_QUEEN]  | this->bitboards[(int)Piece::BLACK_QUEEN];
+    U64 orth = this->bitboards[(int)Piece::WHITE_ROOK]   | this->bitboards[(int)Piece::BLACK_ROOK]
+             | this->bitboards[(int)Piece::WHITE_QUEEN]  | this->bitboards[(int)Piece::BLACK_QUEEN];
+
+    int side = std::is_same<Color, White>::value ? 0 : 1; // side that just captured
+    int res = 1;
+
+    while (true) {
+        side ^= 1;
+        attackers &= occ;
+        U64 side_attackers = attackers & this->bitboards[side ? (int)Piece::BLACK_ALL : (int)Piece::WHITE_ALL];
+        if (!side_attackers) break;
+        res ^= 1;
+
+        // least valuable attacker recaptures.
+        int pc = 0;
+        U64 pc_attackers = 0ULL;
+        for (; pc < 6; pc++) {
+            pc_attackers = side_attackers & this->bitboards[side * 6 + pc];
+            if (pc_attackers) break;
+        }
+
+        // a king can only recapture if nothing is left to take it back.
+        if (pc == 5) {
+            U64 opp_attackers = attackers & ~side_attackers;
+            return opp_attackers ? res ^ 1 : res;
+        }
+
+        swap = SEE_VALS[pc] - swap;
+        if (swap < res) break;
+
+        occ ^= 1ULL << lsb(pc_attackers);
+        if ((pc == 0) | (pc == 2) | (pc == 4)) attackers |= KMAGICS::get_b_attacks(to, occ) & diag;
+        if ((pc == 3) | (pc == 4))             attackers |= KMAGICS::get_r_attacks(to, occ) & orth;
+    }
+
+    return res;
+}
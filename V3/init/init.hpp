@@ -5,10 +5,16 @@
 #include "mapped_moves.hpp"
 #include "zobrist.hpp"
 #include "pestos.hpp"
+#include "reductions.hpp"
+#include "../board/TranspositionTable.hpp"
+#include "../search/PawnTable.hpp"
 
 void init() {
     MAPPED_MOVES::init();
     KMAGICS::init();
     ZOBRIST::init();
     PeSTOs::init();
+    REDUCTIONS::init();
+    PawnTable::init();
+    TranspositionTable::resize(TranspositionTable::DEFAULT_MB);
 }
\ No newline at end of file
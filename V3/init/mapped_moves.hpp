@@ -2,6 +2,7 @@
 
 #include "../util/types.hpp"
 #include "../util/data.hpp"
+#include "../util/util.hpp"
 #include <vector>
 
 namespace MAPPED_MOVES {
@@ -9,6 +10,7 @@ namespace MAPPED_MOVES {
     U64 KING_MOVES[NUM_SQUARES];
 
     U64 BITS_BETWEEN[NUM_SQUARES][NUM_SQUARES];
+    U64 BITS_RAY[NUM_SQUARES][NUM_SQUARES]; // from sq through sq2 to the edge
 
     typedef std::vector<std::pair<int, int>> DIRS;
 
@@ -68,6 +70,11 @@ namespace MAPPED_MOVES {
                     BITS_BETWEEN[sq][sq2] = cum; // cum is currently between sq & sq2.
                     cum |= 1ULL << sq2; // cum now includes sq2
                 }
+
+                U64 ray = cum; // cum is now the whole ray.
+                while (cum) {
+                    BITS_RAY[sq][pop_lsb(cum)] = ray;
+                }
             }
         }
     }
@@ -0,0 +1,180 @@
+/* HalfKP-style neural evaluator (optional backend behind Evaluate). */
+
+// Network: 2 x [40960 -> 128] feature transformer (int16), one per side's
+// king, then clipped-relu([white 128 | black 128]) -> 1 (int8 weights).
+//
+// Feature (per perspective): king_sq * 640 + (type * 2 + is_enemy) * 64 + sq
+// for every non-king piece, with squares mirrored vertically for black.
+//
+// File (little-endian): "MCNN" | U32 version | I16 ft_bias[128]
+//                       | I16 ft_weights[40960][128] | I32 out_bias
+//                       | I8 out_weights[256]
+
+#pragma once
+
+#include "../util/types.hpp"
+#include "../util/util.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace NNUE {
+
+    // Constants
+
+    constexpr int L1           = 128;
+    constexpr int NUM_FEATURES = 64 * 10 * 64;
+    constexpr U32 VERSION      = 1;
+    constexpr int CRELU_MAX    = 127;
+    constexpr int OUTPUT_SCALE = 400;               // cp per unit of output
+    constexpr int OUTPUT_DIV   = CRELU_MAX * 64;    // QA * QB
+
+    // Weights
+
+    alignas(32) I16 ft_bias[L1];
+    std::vector<I16> ft_weights; // [NUM_FEATURES][L1]
+    I32 out_bias;
+    alignas(32) I16 out_weights[2 * L1]; // widened from the file's int8
+
+    bool loaded = false; // a network is in memory
+    bool active = false; // Board keeps accumulators & Evaluate uses them
+
+    // Accumulator (lives in Board, one per position copy)
+
+    struct Accumulator {
+        alignas(32) I16 values[2][L1]; // [perspective][neuron]
+        bool dirty[2] = { true, true }; // needs a refresh from scratch
+    };
+
+    // Features
+
+    inline int feature_index(int persp, Square king_sq, Piece pc, Square sq) {
+        int pc_idx  = (int)pc;
+        int is_black = pc_idx >= 6;
+        int type    = pc_idx - 6 * is_black;
+        int orient  = persp ? 56 : 0;
+        int is_enemy = is_black ^ persp;
+        return ((int)(king_sq ^ orient) * 10 + type * 2 + is_enemy) * 64
+             + (int)(sq ^ orient);
+    }
+
+    // Kernels
+
+    inline void add_feature(I16* acc, int feature) {
+        const I16* w = &ft_weights[(size_t)feature * L1];
+#if defined(__AVX2__)
+        for (int i = 0; i < L1; i += 16) {
+            __m256i a = _mm256_load_si256((__m256i*)(acc + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(w + i));
+            _mm256_store_si256((__m256i*)(acc + i), _mm256_add_epi16(a, b));
+        }
+#else
+        for (int i = 0; i < L1; i++) acc[i] += w[i];
+#endif
+    }
+
+    inline void sub_feature(I16* acc, int feature) {
+        const I16* w = &ft_weights[(size_t)feature * L1];
+#if defined(__AVX2__)
+        for (int i = 0; i < L1; i += 16) {
+            __m256i a = _mm256_load_si256((__m256i*)(acc + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(w + i));
+            _mm256_store_si256((__m256i*)(acc + i), _mm256_sub_epi16(a, b));
+        }
+#else
+        for (int i = 0; i < L1; i++) acc[i] -= w[i];
+#endif
+    }
+
+    inline void reset(I16* acc) {
+        std::memcpy(acc, ft_bias, sizeof(ft_bias));
+    }
+
+    // clipped relu over both halves, dotted with the output layer.
+    // returns a white-relative score (white half is always first).
+    inline int forward(Accumulator& acc) {
+        I32 sum = 0;
+#if defined(__AVX2__)
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i cmax = _mm256_set1_epi16(CRELU_MAX);
+        __m256i vsum = _mm256_setzero_si256();
+        for (int p = 0; p < 2; p++) {
+            for (int i = 0; i < L1; i += 16) {
+                __m256i a = _mm256_load_si256((__m256i*)(acc.values[p] + i));
+                __m256i w = _mm256_load_si256((__m256i*)(out_weights + p * L1 + i));
+                a = _mm256_min_epi16(_mm256_max_epi16(a, zero), cmax);
+                vsum = _mm256_add_epi32(vsum, _mm256_madd_epi16(a, w));
+            }
+        }
+        __m128i s = _mm_add_epi32(_mm256_castsi256_si128(vsum), _mm256_extracti128_si256(vsum, 1));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0b01001110));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0b10110001));
+        sum = _mm_cvtsi128_si32(s);
+#else
+        for (int p = 0; p < 2; p++) {
+            for (int i = 0; i < L1; i++) {
+                int a = acc.values[p][i];
+                a = a < 0 ? 0 : a > CRELU_MAX ? CRELU_MAX : a;
+                sum += a * out_weights[p * L1 + i];
+            }
+        }
+#endif
+        return (int)(((I64)sum + out_bias) * OUTPUT_SCALE / OUTPUT_DIV);
+    }
+
+    // Loading
+
+    bool load(std::string fname) {
+        std::ifstream in(fname, std::ios::binary);
+        char magic[4]; U32 version;
+        in.read(magic, 4);
+        in.read((char*)&version, sizeof(version));
+        if (!in || std::memcmp(magic, "MCNN", 4) != 0 || version != VERSION) {
+            std::cout << "info string invalid network file " << fname << "\n";
+            return false;
+        }
+
+        // read into temporaries: a truncated file leaves the current net as is.
+        std::vector<I16> new_ft_weights((size_t)NUM_FEATURES * L1);
+        I16 new_ft_bias[L1];
+        I32 new_out_bias;
+        I8 out_w8[2 * L1];
+        in.read((char*)new_ft_bias, sizeof(new_ft_bias));
+        in.read((char*)new_ft_weights.data(), new_ft_weights.size() * sizeof(I16));
+        in.read((char*)&new_out_bias, sizeof(new_out_bias));
+        in.read((char*)out_w8, sizeof(out_w8));
+        if (!in) {
+            std::cout << "info string truncated network file " << fname << "\n";
+            return false;
+        }
+
+        ft_weights.swap(new_ft_weights);
+        std::memcpy(ft_bias, new_ft_bias, sizeof(ft_bias));
+        out_bias = new_out_bias;
+        for (int i = 0; i < 2 * L1; i++) out_weights[i] = out_w8[i];
+
+        loaded = true;
+        return true;
+    }
+
+    // small random network, only meant for throughput benchmarks.
+    void init_random(U64 seed) {
+        auto next = [&]() {
+            seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+            return seed;
+        };
+        ft_weights.resize((size_t)NUM_FEATURES * L1);
+        for (I16& w : ft_weights) w = (I16)(next() % 17) - 8;
+        for (I16& w : ft_bias) w = (I16)(next() % 33);
+        for (I16& w : out_weights) w = (I16)(next() % 255) - 127;
+        out_bias = 0;
+        loaded = true;
+    }
+};
@@ -160,10 +160,16 @@ namespace PeSTOs {
         eg_king_table
     };
 
-    int gamephaseInc[12] = {0,0,1,1,1,1,2,2,4,4,0,0};
+    int gamephaseInc[6] = { 0, 1, 1, 2, 4, 0 }; // by piece type
     int mg_table[12][64];
     int eg_table[12][64];
 
+    // signed (white +, black -) per-square deltas for Board's incremental
+    // accumulators. rows 12..15 (aggregates, NA) are zero.
+    int mg_incr[16][64] = {};
+    int eg_incr[16][64] = {};
+    int phase_incr[16] = {};
+
     void init() {
         for (int pc = 0; pc < 6; pc++) {
             for (int sq = 0; sq < 64; sq++) {
@@ -171,11 +177,31 @@ namespace PeSTOs {
                 eg_table[pc]  [sq] = eg_value[pc] + eg_pesto_table[pc][sq];
                 mg_table[pc+6][sq] = mg_value[pc] + mg_pesto_table[pc][sq ^ 56];
                 eg_table[pc+6][sq] = eg_value[pc] + eg_pesto_table[pc][sq ^ 56];
+
+                mg_incr[pc]  [sq] =  mg_table[pc]  [sq];
+                eg_incr[pc]  [sq] =  eg_table[pc]  [sq];
+                mg_incr[pc+6][sq] = -mg_table[pc+6][sq];
+                eg_incr[pc+6][sq] = -eg_table[pc+6][sq];
             }
+            phase_incr[pc]     = gamephaseInc[pc];
+            phase_incr[pc + 6] = gamephaseInc[pc];
         }
     }
 
+    int taper(int mgScore, int egScore, int gamePhase) {
+        int mgPhase = gamePhase;
+        if (mgPhase > 24) mgPhase = 24; /* in case of early promotion */
+        int egPhase = 24 - mgPhase;
+        return (mgScore * mgPhase + egScore * egPhase) / 24;
+    }
+
+    /* O(1): reads the accumulators Board keeps in set_board */
     int eval(Board& b) {
+        return taper(b.get_mg_score(), b.get_eg_score(), b.get_game_phase());
+    }
+
+    /* full board scan, used to cross-check the accumulators */
+    int eval_full(Board& b) {
         int mg[2] = { 0, 0 };
         int eg[2] = { 0, 0 };
         int gamePhase = 0;
@@ -187,17 +213,12 @@ namespace PeSTOs {
                 bool color = (int)pc < 6;
                 mg[color] += mg_table[(int)pc][sq];
                 eg[color] += eg_table[(int)pc][sq];
-                gamePhase += gamephaseInc[(int)pc];
+                gamePhase += phase_incr[(int)pc];
             }
         }
 
         /* tapered eval */
-        int mgScore = mg[1] - mg[0];
-        int egScore = eg[1] - eg[0];
-        int mgPhase = gamePhase;
-        if (mgPhase > 24) mgPhase = 24; /* in case of early promotion */
-        int egPhase = 24 - mgPhase;
-        return (mgScore * mgPhase + egScore * egPhase) / 24;
+        return taper(mg[1] - mg[0], eg[1] - eg[0], gamePhase);
     }
 
 };
\ No newline at end of file
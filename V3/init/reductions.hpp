@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../util/data.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Late move reductions: r(depth, move #) = 0.75 + ln(depth) * ln(move #) / 2.25,
+// filled once at init so nega_max only does a lookup.
+
+namespace REDUCTIONS {
+    U8 table[MAX_DEPTH + 1][MAX_NUM_MOVES];
+
+    void init() {
+        for (int d = 0; d <= MAX_DEPTH; d++) {
+            for (int m = 0; m < MAX_NUM_MOVES; m++) {
+                double r = (d && m) ? 0.75 + std::log(d) * std::log(m) / 2.25 : 0.0;
+                table[d][m] = (U8)std::max(0.0, r);
+            }
+        }
+    }
+
+    U16 get(U16 depth, int move_idx) {
+        return table[std::min(depth, (U16)MAX_DEPTH)][std::min(move_idx, MAX_NUM_MOVES - 1)];
+    }
+};
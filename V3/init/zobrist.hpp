@@ -11,6 +11,7 @@
 namespace ZOBRIST {
     U64 piece_rands[16][64];
     U64 turn_rand;
+    U64 en_passant_rands[64]; // [0] = no en passant (not in Context::hash)
 
     U64 get_rand() {
         U64 x = 0;
@@ -33,5 +34,9 @@ namespace ZOBRIST {
                 piece_rands[i][j] = 0;
             }
         }
+        en_passant_rands[0] = 0;
+        for (int j = 1; j < 64; j++) {
+            en_passant_rands[j] = get_rand();
+        }
     }
 };
\ No newline at end of file
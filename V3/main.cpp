@@ -26,49 +26,53 @@ int main(int argc, char** argv) {
 
     auto [ move, score ] = Search::search<White>(b, ctx, 10);
     std::cout << "info string: " << score << "\n";
-    time_fn([]() {
-        
-
-        string testing_fen[] = {
-            "startpos",
-            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
-            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
-            "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
-            "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1",
-            "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
-            "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"
-        };
-
-        for (string& fen : testing_fen) {
-            bool turn;
-            Context ctx = b.from_fen(fen, turn);
-            if (turn) Search::search<White>(b, ctx, depth);
-                 else Search::search<Black>(b, ctx, depth);
-            // if (turn) Perft::run<White>(b, ctx, depth);
-            //      else Perft::run<Black>(b, ctx, depth);
-        }
-    });
+    Search::bench(depth, 1, TranspositionTable::DEFAULT_MB);
 
     U64 num = 0, den = 0;
     U64 negamax_nodes = 0;
     for (int i = 0; i <= depth; i++) {
-        if (i != depth) num += Search::node_depth_hist[i];
-        if (i != 0) den += Search::node_depth_hist[i];
+        if (i != depth) num += Search::total_node_depth_hist[i];
+        if (i != 0) den += Search::total_node_depth_hist[i];
     }
-    std::cout << "\nnodes:\t" << (Search::negamax_nodes + Search::quiesce_nodes)
+    std::cout << "\nnodes:\t" << (Search::total_negamax_nodes + Search::total_quiesce_nodes)
               << "\nbf:\t" << (num + 0.0) / (den + 0.0)
               << "\n";
 
-    std::cout << "\nNull Move Searches:\t" << Search::null_searches
-              << "\nNull Move Hits:\t" << Search::null_cutoffs
+    std::cout << "\nNull Move Searches:\t" << Search::total_null_searches
+              << "\nNull Move Hits:\t" << Search::total_null_cutoffs
+              << "\n";
+
+    std::cout << "\nLMR Searches:\t"   << Search::total_lmr_searches
+              << "\nLMR Re-searches:\t" << Search::total_lmr_researches
+              << "\n";
+
+    std::cout << "\nRFP Cutoffs:\t"     << Search::total_rfp_cutoffs
+              << "\nRazor Cutoffs:\t"   << Search::total_razor_cutoffs
+              << "\nFutility Prunes:\t" << Search::total_futility_prunes
+              << "\nMaterial Draws:\t"  << Search::total_material_draws
               << "\n";
 
-    std::cout << "\nkiller hits:\t"   << KillerTable::hits
-              << "\nkiller misses:\t" << KillerTable::misses
-              << "\nkiller hitrate:\t"  << (KillerTable::hits + 0.0) / (KillerTable::hits + KillerTable::misses + 0.0)
+    std::cout << "\nkiller hits:\t"   << KillerTable::total_hits
+              << "\nkiller misses:\t" << KillerTable::total_misses
+              << "\nkiller hitrate:\t"  << (KillerTable::total_hits + 0.0) / (KillerTable::total_hits + KillerTable::total_misses + 0.0)
               << "\n";
 
-    std::cout << "\ntt hits:\t"     << TranspositionTable::hits
-              << "\ntt misses:\t"   << TranspositionTable::misses
-              << "\ntt hitrate:\t"   << (TranspositionTable::hits + 0.0) / (TranspositionTable::hits + TranspositionTable::misses + 0.0);
+    std::cout << "\ntt hits:\t"     << TranspositionTable::total_hits
+              << "\ntt misses:\t"   << TranspositionTable::total_misses
+              << "\ntt hitrate:\t"   << (TranspositionTable::total_hits + 0.0) / (TranspositionTable::total_hits + TranspositionTable::total_misses + 0.0)
+              << "\n\n";
+    std::cout << "eval hits:\t"     << EvalCache::total_hits
+              << "\neval tt hits:\t"  << EvalCache::total_tt_hits
+              << "\neval misses:\t"   << EvalCache::total_misses
+              << "\neval hitrate:\t"  << (EvalCache::total_hits + EvalCache::total_tt_hits + 0.0) / (EvalCache::total_hits + EvalCache::total_tt_hits + EvalCache::total_misses + 0.0)
+              << "\n\n";
+    std::cout << "pawn hits:\t"     << PawnTable::total_hits
+              << "\npawn misses:\t"   << PawnTable::total_misses
+              << "\npawn hitrate:\t"  << (PawnTable::total_hits + 0.0) / (PawnTable::total_hits + PawnTable::total_misses + 0.0)
+              << "\n\n";
+    std::cout << "material hits:\t"     << MaterialTable::total_hits
+              << "\nmaterial misses:\t"   << MaterialTable::total_misses
+              << "\nmaterial hitrate:\t"  << (MaterialTable::total_hits + 0.0) / (MaterialTable::total_hits + MaterialTable::total_misses + 0.0)
+              << "\n\n";
+    TranspositionTable::print_info();
 }
\ No newline at end of file
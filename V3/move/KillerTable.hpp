@@ -3,26 +3,104 @@
 #include "Move.hpp"
 
 #include <array>
+#include <atomic>
+#include <cstring>
 
-// Move DS: [-----SC-----|CAPT|FLAG|-FROM-|--TO--]
+// killers & countermoves hold canonical 16-bit moves (Move::get_masked).
 
 constexpr bool USE_KILLER_TABLE = true;
 
+// Quiet ordering beyond the killers, all indexed by [piece][to] so they
+// stay colour-aware:
+//  - history:      butterfly [turn][from][to], as before.
+//  - countermoves: the quiet that last refuted the previous move.
+//  - cont_history: [1 or 2 plies back][prev piece][prev to][piece][to].
+// Histories use gravity updates (v += b - v * |b| / MAX_HIST), so they
+// saturate smoothly within +-MAX_HIST instead of growing without bound.
+
 namespace KillerTable {
     constexpr size_t SLOTS = 2;
+    constexpr int MAX_HIST = 16384;
+    constexpr int MAX_BONUS = 1200;
+    constexpr int MAX_PLY = MAX_DEPTH + 1;
+
+    struct PieceTo {
+        Piece pc = Piece::NA; // NA: null move / no move
+        Square to = 0;
+    };
+
+    // per-thread stats, summed into the totals by flush_stats().
+
+    thread_local U64 hits = 0;
+    thread_local U64 fill = 0;
+    thread_local U64 misses = 0;
+    thread_local U64 calls = 0;
+
+    std::atomic<U64> total_hits = 0;
+    std::atomic<U64> total_misses = 0;
+
+    // per-thread tables (each search thread orders its own moves).
+
+    thread_local U16 killers[MAX_DEPTH][SLOTS] = {};
+    thread_local I16 history[2][NUM_SQUARES][NUM_SQUARES] = {};
+    thread_local U16 countermoves[12][NUM_SQUARES] = {};
+    thread_local I16 cont_history[2][12][NUM_SQUARES][12][NUM_SQUARES] = {};
+
+    // move played at each ply of the current line (set by nega_max).
+
+    thread_local PieceTo played[MAX_PLY];
+
+    // the previous move `back` plies up the line, if there is one.
+    PieceTo get_played(U16 ply, int back) {
+        return ply >= back ? played[ply - back] : PieceTo();
+    }
+
+    U16 get_countermove(U16 ply) {
+        PieceTo prev = get_played(ply, 1);
+        return prev.pc < Piece::WHITE_ALL ? countermoves[(int)prev.pc][prev.to] : 0;
+    }
+
+    // butterfly + 1 and 2 ply continuation histories, in +-3 * MAX_HIST.
+    int get_quiet_hist(bool turn, Piece pc, Square from, Square to, U16 ply) {
+        int score = history[turn][from][to];
+        for (int back = 1; back <= 2; back++) {
+            PieceTo prev = get_played(ply, back);
+            if (prev.pc < Piece::WHITE_ALL) {
+                score += cont_history[back - 1][(int)prev.pc][prev.to][(int)pc][to];
+            }
+        }
+        return score;
+    }
+
+    void apply_bonus(I16& v, int bonus) {
+        v += bonus - v * std::abs(bonus) / MAX_HIST;
+    }
 
-    U64 hits = 0;
-    U64 fill = 0;
-    U64 misses = 0;
-    U64 calls = 0;
+    void update_quiet_hist(bool turn, Piece pc, Square from, Square to, U16 ply, int bonus) {
+        apply_bonus(history[turn][from][to], bonus);
+        for (int back = 1; back <= 2; back++) {
+            PieceTo prev = get_played(ply, back);
+            if (prev.pc < Piece::WHITE_ALL) {
+                apply_bonus(cont_history[back - 1][(int)prev.pc][prev.to][(int)pc][to], bonus);
+            }
+        }
+    }
 
-    U32 killers[MAX_DEPTH][SLOTS] = {};
-    U32 history[2][NUM_SQUARES][NUM_SQUARES] = {};
+    // quiet cutoff: reward it and make it the previous move's countermove.
+    void add_quiet_cutoff(bool turn, Move& m, Piece pc, U16 depth, U16 ply) {
+        int bonus = std::min(32 * depth * depth, MAX_BONUS);
+        update_quiet_hist(turn, pc, m.get_from(), m.get_to(), ply, bonus);
+
+        PieceTo prev = get_played(ply, 1);
+        if (prev.pc < Piece::WHITE_ALL) {
+            countermoves[(int)prev.pc][prev.to] = m.get_masked();
+        }
+    }
 
     bool has_move(Move& m, U16 depth) {
         if constexpr (!USE_KILLER_TABLE) return false;
 
-        U32 target = m.get_masked();
+        U16 target = m.get_masked();
         bool is_hit = false;
         for (int i = 0; i < SLOTS; i++) {
             is_hit |= (killers[depth][i] == target);
@@ -37,31 +115,33 @@ namespace KillerTable {
         return has_move(m, depth);
     }
 
-    void add_move(bool turn, Move& m, U16 depth) {
+    void add_move(Move& m, U16 depth) {
         if constexpr (!USE_KILLER_TABLE) return;
 
         if (m.get_capture() != Piece::NA) return;
         if (has_move(m, depth)) return;
 
-        history[turn][m.get_from()][m.get_to()] += depth * depth;
-
         for (int i = SLOTS - 1; i >= 1; i--) {
             killers[depth][i] = killers[depth][i - 1];
         }
         killers[depth][0] = m.get_masked();
     }
 
+    void flush_stats() {
+        total_hits += hits;
+        total_misses += misses;
+        hits = 0;
+        misses = 0;
+    }
+
     void clear_cells() {
         for (auto& slots : killers) {
-            slots[0] = 0U;
-            slots[1] = 0U;
-        }
-        for (auto& x : history) {
-            for (auto& y : x) {
-                for (auto& z : y) {
-                    z = 0U;
-                }
-            }
+            slots[0] = 0;
+            slots[1] = 0;
         }
+        std::memset(history, 0, sizeof(history));
+        std::memset(countermoves, 0, sizeof(countermoves));
+        std::memset(cont_history, 0, sizeof(cont_history));
+        for (auto& p : played) p = PieceTo();
     }
 };
\ No newline at end of file
@@ -10,7 +10,10 @@
 struct Move {
     static U32 MOVE_MASK;
 
-    U32 data; // [-----SC----|R|CAPT|FLAG|-FROM-|--TO--]
+    // [R|CAPT|FLAG|-FROM-|--TO--]: the low 16 bits are the canonical move
+    // (all the TT, killers and histories store), capture & reversability
+    // are filled in for do/undo. ordering scores live in the MoveList.
+    U32 data;
 
     Move();
     Move(U32 data);
@@ -25,20 +28,19 @@ struct Move {
     Square get_from();
     Square get_to();
     U32&   get_raw();
-    U32    get_masked();
+    U16    get_masked();
 
     U64 get_from_bit();
     U64 get_to_bit();
 
-    template<class Color, GenType Gn> void set_score_capt(void* b, Move& priority, U16 depth);
+    template<class Color, GenType Gn> U32 set_score_capt(void* b, Move& priority, U16 depth, U16 ply = 0);
     U32 get_move_score(Piece pc, Piece capt, Flag flag, U16 depth, Move& priority);
     U32 get_capture_score(Piece pc, Piece capt, Flag flag, U16 depth, Move& priority);
-    U32 get_quiet_score(Piece pc, Flag flag, Square from, Square to, U16 depth, Move& priority);
+    U32 get_quiet_score(Piece pc, Flag flag, Square from, Square to, U16 depth, U16 ply, Move& priority);
 
     bool operator==(const Move& m);
-    bool operator> (const Move& m);
 
     std::string to_string();
 };
 
-U32 Move::MOVE_MASK = (1U << 21) - 1U;
\ No newline at end of file
+U32 Move::MOVE_MASK = (1U << 16) - 1U;
\ No newline at end of file
@@ -3,14 +3,22 @@
 #include "Move.hpp"
 #include <array>
 
+// moves and their ordering keys are kept in parallel arrays, so picking
+// the best move only scans the dense keys. a key is the 11-bit score over
+// the move's own 21 bits, which keeps ties in the order they always had.
+
 class MoveList {
     std::array<Move, MAX_NUM_MOVES> move_list;
+    std::array<U32, MAX_NUM_MOVES> scores;
     int cnt = 0;
 
 public:
     MoveList();
 
     Move& operator[](int i);
+    void set_score(int i, U32 score);
+    void swap(int i, int j);
+    int best_in(int begin, int end); // index of the highest score
     void clear();
     int& size();
 
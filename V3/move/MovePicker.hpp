@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Move.hpp"
+#include "MoveList.hpp"
+#include "KillerTable.hpp"
+
+class Board;
+struct Context;
+
+// Hands out legal moves one at a time, generating & scoring each stage only once
+// it's reached (a node that cuts off on the TT move generates nothing):
+//      1. TT-suggestion  -> checked with is_legal, no generation
+//      2. Good Captures  -> SEE >= 0 (promos & en passant count as even)
+//      3. Killers        -> checked with is_legal, no generation
+//      4. Bad Captures   -> SEE < 0
+//      5. Quiets         -> Promos, countermove, then by history (order.hpp)
+// Every stage is drained by partial selection (swap the best left to the
+// front), so unsearched moves are never sorted. CAPTURES pickers (quiesce)
+// only run stages 2 and 4.
+//
+// Within a capture stage moves are still ordered by MVV-LVA. Bad captures
+// stay ahead of the quiets: with SEE in place, trying them last still costs
+// +26% bench nodes at depth 9 (517k -> 651k), mostly because the quiets
+// then get earlier move numbers and less LMR.
+
+enum class Stage {
+    TT_MOVE,
+    GEN_CAPTURES,
+    GOOD_CAPTURES,
+    KILLERS,
+    BAD_CAPTURES,
+    GEN_QUIETS,
+    QUIETS,
+    DONE
+};
+
+template<class Color, GenType Gn>
+class MovePicker {
+    Board& b;
+    Context& ctx;
+    U16 depth;
+    U16 ply; // continuation history / countermove context (0: none)
+    Stage stage;
+
+    MoveList ml;      // [ good captures | bad captures | quiets ]
+    int cur      = 0; // next slot of the current stage
+    int good_end = 0;
+    int capt_end = 0;
+
+    Move tt_move;
+    Move killers[KillerTable::SLOTS];
+    int killer_idx = 0;
+    int num_killers = 0;
+
+    Move select(int end);
+    bool is_known(Move& m);
+
+public:
+    MovePicker(Board& b, Context& ctx, Move tt_move = Move(), U16 depth = 0, U16 ply = 0);
+
+    Move next(); // Move() once every stage is drained
+    Stage get_stage() { return stage; }
+};
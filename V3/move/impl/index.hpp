@@ -2,4 +2,5 @@
 
 #include "move.hpp"
 #include "movelist.hpp"
-#include "order.hpp"
\ No newline at end of file
+#include "order.hpp"
+#include "picker.hpp"
@@ -44,8 +44,8 @@ U32& Move::get_raw() {
     return data;
 }
 
-U32 Move::get_masked() {
-    return data & Move::MOVE_MASK;
+U16 Move::get_masked() {
+    return (U16)(data & Move::MOVE_MASK);
 }
 
 U32 Move::get_reversable() {
@@ -64,10 +64,6 @@ bool Move::operator==(const Move& m) {
     return this->data == m.data;
 }
 
-bool Move::operator>(const Move& m) {
-    return this->data > m.data;
-}
-
 std::string Move::to_string() {
     std::string base = square_num_to_string((int)get_from())
                      + square_num_to_string((int)get_to());
@@ -8,6 +8,23 @@ Move& MoveList::operator[](int i) {
     return move_list[i];
 }
 
+void MoveList::set_score(int i, U32 score) {
+    scores[i] = (score << 21) | move_list[i].get_raw();
+}
+
+void MoveList::swap(int i, int j) {
+    std::swap(move_list[i], move_list[j]);
+    std::swap(scores[i], scores[j]);
+}
+
+int MoveList::best_in(int begin, int end) {
+    int best = begin;
+    for (int i = begin + 1; i < end; i++) {
+        best = scores[i] > scores[best] ? i : best;
+    }
+    return best;
+}
+
 void MoveList::clear() {
     cnt = 0;
 }
@@ -10,7 +10,8 @@
 //      3. Neutral Captures                   -> Victim - Aggressor (= 0) + CAPT_SCORE
 //      4. Killers                            -> CAPT_SCORE - 1
 //      5. Negative Captures                  -> Victim - Aggressor (< 0) + CAPT_SCORE
-//      6. Quiets                             -> Min(Hist, QUIET_SCORE)
+//      6. Quiets                             -> Countermove = QUIET_SCORE,
+//                                               else Hist scaled into [0, QUIET_SCORE)
 
 // Calculating CAPT_SCORE:
 //      MIN(Negative Captures) = QUIET_SCORE + 1
@@ -18,7 +19,8 @@
 //      CAPT_SCORE = PC_VALS[KING] - PC_VALS[PAWN] + QUIET_SCORE + 1
 
 // QUIET_SCORE
-//      MAX(Hist)? Idk, I'll guess 255.
+//      Hist = butterfly + 2 continuation histories (KillerTable), each in
+//      +-MAX_HIST, so HIST_SCALE maps the sum's 6 * MAX_HIST span onto 256.
 
 // PROMO FORMULA:
 //      PROMO_ADJ = CAPTURE_BONUS + PC_VALS[PROMO_PC]
@@ -36,6 +38,8 @@ constexpr U32 MAX_SCORE = (0b1U << 11) - 1U;
 
 constexpr U32 QUIET_SCORE = 255U;
 
+constexpr int HIST_SCALE = 6 * KillerTable::MAX_HIST / 256;
+
 constexpr U32 CAPT_SCORE = (
     PC_VALS[(int)Piece::WHITE_KING]
     - PC_VALS[(int)Piece::WHITE_PAWN]
@@ -89,7 +93,7 @@ U32 Move::get_capture_score(Piece pc, Piece capt, Flag flag, U16 depth, Move& pr
     );
 }
 
-U32 Move::get_quiet_score(Piece pc, Flag flag, Square from, Square to, U16 depth, Move& priority) {
+U32 Move::get_quiet_score(Piece pc, Flag flag, Square from, Square to, U16 depth, U16 ply, Move& priority) {
     bool not_known = true;
     bool is_priority = (this->get_masked() == priority.get_masked());
     not_known &= !is_priority;
@@ -101,8 +105,10 @@ U32 Move::get_quiet_score(Piece pc, Flag flag, Square from, Square to, U16 depth
 
     U32 priority_bonus = MAX_SCORE;
     U32 killer_bonus   = CAPT_SCORE - 1U;
-    U32 hist_bonus     = KillerTable::history[pc <= Piece::WHITE_KING][this->get_from()][this->get_to()];
-    U32 quiet_bonus    = std::min(hist_bonus, QUIET_SCORE);
+    bool is_counter    = KillerTable::get_countermove(ply) == this->get_masked();
+    int  hist          = KillerTable::get_quiet_hist(pc <= Piece::WHITE_KING, pc, from, to, ply);
+    U32  hist_bonus    = (U32)std::clamp(hist / HIST_SCALE + 128, 0, (int)QUIET_SCORE - 1);
+    U32  quiet_bonus   = is_counter ? QUIET_SCORE : hist_bonus;
     U32 promo_bonus    = CAPT_SCORE - PC_VALS[(int)Piece::WHITE_PAWN] + FLAG_VALS[(int)flag];
 
     return (
@@ -114,7 +120,7 @@ U32 Move::get_quiet_score(Piece pc, Flag flag, Square from, Square to, U16 depth
 }
 
 template<class Color, GenType Gn>
-void Move::set_score_capt(void* b_ptr, Move& priority, U16 depth) { 
+U32 Move::set_score_capt(void* b_ptr, Move& priority, U16 depth, U16 ply) {
     Board& b = *((Board*) b_ptr);
 
     Square from = this->get_from();
@@ -142,16 +148,14 @@ void Move::set_score_capt(void* b_ptr, Move& priority, U16 depth) {
         this->data |= is_reversable << 20;
     }
 
-    // set score
+    // return score
 
     if constexpr (Gn == GenType::CAPTURES) {
-        U32 score = this->get_capture_score(pc, capt, flag, depth, priority);
-        this->data |= score << 21;
+        return this->get_capture_score(pc, capt, flag, depth, priority);
     } else {
-        U32 score = capt == Piece::NA
-            ? this->get_quiet_score(pc, flag, from, to, depth, priority)
+        return capt == Piece::NA
+            ? this->get_quiet_score(pc, flag, from, to, depth, ply, priority)
             : this->get_capture_score(pc, capt, flag, depth, priority);
-        this->data |= score << 21;
     }
 }
 
@@ -162,17 +166,20 @@ void MoveList::fill_moves(
     Move priority
 ) {
     for (int i = 0; i < cnt; i++) {
-        move_list[i].set_score_capt<Color, Gn>(b, priority, depth);
+        set_score(i, move_list[i].set_score_capt<Color, Gn>(b, priority, depth));
     }
 }
 
-void MoveList::sort() { // insertion sort
+void MoveList::sort() { // insertion sort, by score
     for (int i = 1; i < cnt; i++) {
         Move subject = move_list[i]; // save value of subject
+        U32 subject_score = scores[i];
         int j;
-        for (j = i - 1; j >= 0 && subject > move_list[j]; j--) {
+        for (j = i - 1; j >= 0 && subject_score > scores[j]; j--) {
             move_list[j + 1] = move_list[j];
+            scores[j + 1] = scores[j];
         }
         move_list[j + 1] = subject; // insert subject
+        scores[j + 1] = subject_score;
     }
 }
\ No newline at end of file
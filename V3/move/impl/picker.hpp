@@ -0,0 +1,120 @@
+#pragma once
+
+#include "../MovePicker.hpp"
+#include "../../board/Board.hpp"
+#include "order.hpp"
+
+template<class Color, GenType Gn>
+MovePicker<Color, Gn>::MovePicker(Board& b, Context& ctx, Move tt_move, U16 depth, U16 ply)
+    : b(b), ctx(ctx), depth(depth), ply(ply), tt_move(tt_move) {
+    stage = Gn == GenType::CAPTURES ? Stage::GEN_CAPTURES : Stage::TT_MOVE;
+    if constexpr (Gn == GenType::CAPTURES) this->tt_move = Move();
+}
+
+// partial selection: moves the best of [cur, end) to cur and returns it.
+template<class Color, GenType Gn>
+Move MovePicker<Color, Gn>::select(int end) {
+    ml.swap(cur, ml.best_in(cur, end));
+    return ml[cur++];
+}
+
+// already handed out by the TT / killer stages.
+template<class Color, GenType Gn>
+bool MovePicker<Color, Gn>::is_known(Move& m) {
+    bool known = m.get_masked() == tt_move.get_masked();
+    for (int i = 0; i < num_killers; i++) {
+        known |= m.get_masked() == killers[i].get_masked();
+    }
+    return known;
+}
+
+template<class Color, GenType Gn>
+Move MovePicker<Color, Gn>::next() {
+    Move no_priority;
+
+    switch (stage) {
+    case Stage::TT_MOVE:
+        stage = Stage::GEN_CAPTURES;
+        if (tt_move.get_raw() && b.is_legal<Color>(tt_move, ctx)) {
+            tt_move = Move(tt_move.get_from(), tt_move.get_to(), tt_move.get_flag());
+            tt_move.set_score_capt<Color, GenType::PSEUDOS>(&b, no_priority, depth, ply);
+            return tt_move;
+        }
+        tt_move = Move();
+        [[fallthrough]];
+
+    case Stage::GEN_CAPTURES: {
+        b.gen_legals<Color, GenType::CAPTURES>(ml, ctx);
+        capt_end = ml.size();
+
+        // score, then split off the bad captures (SEE < 0).
+        good_end = capt_end;
+        for (int i = capt_end - 1; i >= 0; i--) {
+            ml.set_score(i, ml[i].set_score_capt<Color, GenType::CAPTURES>(&b, no_priority, depth));
+            if (!b.see<Color>(ml[i], 0)) ml.swap(i, --good_end);
+        }
+        stage = Stage::GOOD_CAPTURES;
+        [[fallthrough]];
+    }
+
+    case Stage::GOOD_CAPTURES:
+        while (cur < good_end) {
+            Move m = select(good_end);
+            if (!is_known(m)) return m;
+        }
+        if constexpr (Gn == GenType::CAPTURES) {
+            stage = Stage::BAD_CAPTURES;
+            return next();
+        }
+        stage = Stage::KILLERS;
+        [[fallthrough]];
+
+    case Stage::KILLERS:
+        while (killer_idx < (int)KillerTable::SLOTS) {
+            Move killer = Move(KillerTable::killers[depth][killer_idx++]);
+            bool is_quiet = (b.get_board(killer.get_to()) == Piece::NA)
+                          & (killer.get_flag() != Flag::EN_PASSANT);
+            if (!killer.get_raw() || !is_quiet || !b.is_legal<Color>(killer, ctx)) continue;
+
+            Move m = Move(killer.get_from(), killer.get_to(), killer.get_flag());
+            m.set_score_capt<Color, GenType::QUIETS>(&b, no_priority, depth, ply);
+            if (is_known(m)) continue;
+            killers[num_killers++] = m;
+            return m;
+        }
+        stage = Stage::BAD_CAPTURES;
+        [[fallthrough]];
+
+    case Stage::BAD_CAPTURES:
+        while (cur < capt_end) {
+            Move m = select(capt_end);
+            if (!is_known(m)) return m;
+        }
+        if constexpr (Gn == GenType::CAPTURES) {
+            stage = Stage::DONE;
+            return Move();
+        }
+        stage = Stage::GEN_QUIETS;
+        [[fallthrough]];
+
+    case Stage::GEN_QUIETS:
+        b.gen_legals<Color, GenType::QUIETS>(ml, ctx);
+        for (int i = capt_end; i < ml.size(); i++) {
+            ml.set_score(i, ml[i].set_score_capt<Color, GenType::QUIETS>(&b, no_priority, depth, ply));
+        }
+        stage = Stage::QUIETS;
+        [[fallthrough]];
+
+    case Stage::QUIETS:
+        while (cur < ml.size()) {
+            Move m = select(ml.size());
+            if (!is_known(m)) return m;
+        }
+        stage = Stage::DONE;
+        [[fallthrough]];
+
+    case Stage::DONE:
+        return Move();
+    }
+    return Move();
+}
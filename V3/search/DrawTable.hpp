@@ -18,9 +18,16 @@ namespace DrawTable {
         U32 sub_hash;
     };
 
-    std::array<Entry, 1024> history;
-    int cnt = 0;
-    int last_non_reversable = 0;
+    // game + search line, one per search thread. helper threads copy the
+    // caller's state in before searching so repetitions are still seen.
+
+    struct State {
+        std::array<Entry, 1024> history = {};
+        int cnt = 0;
+        int last_non_reversable = 0;
+    };
+
+    thread_local State state;
 
     // add position, then return if a draw is detected.
 
@@ -29,19 +36,19 @@ namespace DrawTable {
         U32 is_reversable = last_move.get_reversable();
 
         if (!is_reversable) {
-            last_non_reversable = cnt;
+            state.last_non_reversable = state.cnt;
         }
 
-        history[cnt++] = { is_reversable, sub_hash };
+        state.history[state.cnt++] = { is_reversable, sub_hash };
     }
 
     void pop_position() {
-        cnt--;
+        state.cnt--;
         // item removed was the last non-reversable move, find the new one.
-        if (cnt == last_non_reversable) {
-            last_non_reversable--;
-            while (history[last_non_reversable].is_reversable) {
-                last_non_reversable--;
+        if (state.cnt == state.last_non_reversable) {
+            state.last_non_reversable--;
+            while (state.history[state.last_non_reversable].is_reversable) {
+                state.last_non_reversable--;
             }
         }
     }
@@ -49,13 +56,13 @@ namespace DrawTable {
     // get position repeats and consecutive reversable move counts.
     std::pair<int, int> get_rule_stats() {
         int reps = 1;
-        U32 target_sub_hash = history[cnt - 1].sub_hash;
+        U32 target_sub_hash = state.history[state.cnt - 1].sub_hash;
 
-        for (int ptr = cnt - 2; ptr >= last_non_reversable; ptr--) {
-            reps += (history[ptr].sub_hash == target_sub_hash);
+        for (int ptr = state.cnt - 2; ptr >= state.last_non_reversable; ptr--) {
+            reps += (state.history[ptr].sub_hash == target_sub_hash);
         }
 
-        int reversable_cnt = cnt - 1 - last_non_reversable;
+        int reversable_cnt = state.cnt - 1 - state.last_non_reversable;
 
         return { reps, reversable_cnt };
     }
@@ -70,20 +77,20 @@ namespace DrawTable {
 
     void clear(Context& init_ctx) {
         U32 sub_hash = (U32)init_ctx.hash;
-        history[0] = { false, sub_hash };
-        last_non_reversable = 0;
-        cnt = 1;
+        state.history[0] = { false, sub_hash };
+        state.last_non_reversable = 0;
+        state.cnt = 1;
     }
 
     void print() {
-        for (int i = 0; i < cnt; i++) {
+        for (int i = 0; i < state.cnt; i++) {
             std::cout << i << ": "
-                      << history[i].is_reversable << " "
-                      << std::hex << history[i].sub_hash << std::dec << "\n";
+                      << state.history[i].is_reversable << " "
+                      << std::hex << state.history[i].sub_hash << std::dec << "\n";
         }
         auto [ reps, reversable_cnt ] = get_rule_stats();
         std::cout << "reps: " << reps << "\n";
-        std::cout << "last_non_reversable: " << last_non_reversable << '\n';
+        std::cout << "last_non_reversable: " << state.last_non_reversable << '\n';
         std::cout << "reversable_cnt: " << reversable_cnt << "\n";
         std::cout << "is_draw(): " << is_draw() << "\n";
     }
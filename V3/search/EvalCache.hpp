@@ -0,0 +1,65 @@
+#pragma once
+
+#include "evaluate.hpp"
+#include "../util/data.hpp"
+
+#include <atomic>
+
+// Static eval cache shared by all threads, keyed by Context::hash. The same
+// position is evaluated again by quiesce, after null moves and on every
+// transposition; a hit replaces the whole eval with one load.
+// nega_max first takes the eval the TT keeps next to the score (tt_hits).
+
+constexpr bool USE_EVAL_CACHE = true;
+
+namespace EvalCache {
+    constexpr int INDEX_BITS = 18;
+    constexpr size_t SIZE = 1ULL << INDEX_BITS; // entries (2 MB)
+    constexpr U64 KEY_MASK = ~0ULL << 16;
+
+    // per-thread stats, summed into the totals by flush_stats().
+
+    thread_local U64 hits = 0;
+    thread_local U64 misses = 0;
+    thread_local U64 tt_hits = 0;
+
+    std::atomic<U64> total_hits = 0;
+    std::atomic<U64> total_misses = 0;
+    std::atomic<U64> total_tt_hits = 0;
+
+    // [ 48-bit key (hash's upper bits) | 16-bit white-relative eval ]: one
+    // word, so racing writers can't tear an entry and no xor check is needed.
+    std::atomic<U64> table[SIZE] = {};
+
+    // white-relative, like Evaluate::eval.
+    I16 eval(Board& b, Context& ctx) {
+        if constexpr (!USE_EVAL_CACHE) return Evaluate::eval(b, ctx);
+
+        std::atomic<U64>& e = table[ctx.hash & (SIZE - 1)];
+        U64 data = e.load(std::memory_order_relaxed);
+        if ((data & KEY_MASK) == (ctx.hash & KEY_MASK)) {
+            hits++;
+            return (I16)(U16)data;
+        }
+        misses++;
+
+        I16 eval = Evaluate::eval(b, ctx);
+        e.store((ctx.hash & KEY_MASK) | (U16)eval, std::memory_order_relaxed);
+        return eval;
+    }
+
+    void flush_stats() {
+        total_hits += hits;
+        total_misses += misses;
+        total_tt_hits += tt_hits;
+        hits = 0;
+        misses = 0;
+        tt_hits = 0;
+    }
+
+    // cached evals are backend-specific: cleared with the TT by Search::clear
+    // (ucinewgame & UseNNUE switches).
+    void clear() {
+        for (std::atomic<U64>& e : table) e.store(0, std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "../board/Context.hpp"
+#include "../util/data.hpp"
+
+#include <atomic>
+
+// Material-only knowledge, cached per thread by Context::material_key:
+//  - imbalance: bishop pair (white-relative mg/eg, tapered with PeSTO's).
+//  - scale:     /64 per side, applied when that side is ahead. A pawnless
+//               side that is materially ahead by a minor or less has its
+//               advantage scaled down (0 with just a minor, otherwise 16:
+//               KRvKR, KRvKm, KRBvKR, KQvKQ...); the weaker side's stays at
+//               64. These can still be won, so they are searched normally.
+//  - is_draw:   insufficient material (KvK, KmvK, KmvKm, KNNvK), where no
+//               mate can be forced: nega_max returns 0 instead of searching
+//               to the horizon.
+
+namespace MaterialTable {
+    constexpr int INDEX_BITS = 13;
+    constexpr size_t SIZE = 1ULL << INDEX_BITS; // entries per thread (128 KB)
+    constexpr int SCALE_NORMAL = 64;
+    constexpr int SCALE_DRAWISH = 16;
+    constexpr int BISHOP_PAIR_MG = 30, BISHOP_PAIR_EG = 50;
+
+    struct Entry {
+        U64 key; // 0 never matches: both kings are always counted
+        I16 mg;
+        I16 eg;
+        U8 scale[2]; // [turn]: white's when eval > 0, black's when < 0
+        bool is_draw;
+    };
+
+    // per-thread stats, summed into the totals by flush_stats().
+
+    thread_local U64 hits = 0;
+    thread_local U64 misses = 0;
+
+    std::atomic<U64> total_hits = 0;
+    std::atomic<U64> total_misses = 0;
+
+    thread_local Entry table[SIZE] = {};
+
+    Entry compute(Context& ctx) {
+        int pawns[2], minors[2], majors[2], knights[2], npm[2];
+        for (int side = 0; side < 2; side++) {
+            int base = side ? (int)Piece::WHITE_PAWN : (int)Piece::BLACK_PAWN;
+            int n = ctx.get_count((Piece)(base + 1));
+            int b = ctx.get_count((Piece)(base + 2));
+            int r = ctx.get_count((Piece)(base + 3));
+            int q = ctx.get_count((Piece)(base + 4));
+            pawns[side]   = ctx.get_count((Piece)base);
+            minors[side]  = n + b;
+            majors[side]  = r + q;
+            knights[side] = n;
+            npm[side]     = 3 * (n + b) + 5 * r + 9 * q;
+        }
+
+        Entry e = { ctx.material_key, 0, 0, { SCALE_NORMAL, SCALE_NORMAL }, false };
+
+        for (int side = 0; side < 2; side++) {
+            int sign = side ? 1 : -1;
+            int base = side ? (int)Piece::WHITE_BISHOP : (int)Piece::BLACK_BISHOP;
+            if (ctx.get_count((Piece)base) >= 2) {
+                e.mg += sign * BISHOP_PAIR_MG;
+                e.eg += sign * BISHOP_PAIR_EG;
+            }
+            int lead = npm[side] - npm[!side];
+            if ((pawns[side] == 0) & (lead >= 0) & (lead <= 3)) {
+                e.scale[side] = npm[side] <= 3 ? 0 : SCALE_DRAWISH;
+            }
+        }
+
+        bool no_pawns_majors = !(pawns[0] | pawns[1] | majors[0] | majors[1]);
+        bool lone_minors = (minors[0] <= 1) & (minors[1] <= 1);
+        bool two_knights = ((knights[1] == 2) & (minors[1] == 2) & (minors[0] == 0))
+                         | ((knights[0] == 2) & (minors[0] == 2) & (minors[1] == 0));
+        e.is_draw = no_pawns_majors & (lone_minors | two_knights);
+        if (e.is_draw) e.scale[0] = e.scale[1] = 0;
+
+        return e;
+    }
+
+    Entry& probe(Context& ctx) {
+        // counts aren't random like zobrist keys: mix all 48 bits into the index.
+        Entry& e = table[(ctx.material_key * 0x9E3779B97F4A7C15ULL) >> (64 - INDEX_BITS)];
+        if (e.key == ctx.material_key) {
+            hits++;
+            return e;
+        }
+        misses++;
+        e = compute(ctx);
+        return e;
+    }
+
+    void flush_stats() {
+        total_hits += hits;
+        total_misses += misses;
+        hits = 0;
+        misses = 0;
+    }
+};
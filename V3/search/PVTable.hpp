@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../util/data.hpp"
+#include "../move/Move.hpp"
+
+#include <array>
+#include <string>
+
+// Triangular PV table: row [ply] holds the best line found from ply on,
+// built bottom-up by prepending each node's best move to its child's row.
+// The last completed iteration's root line is kept in prev, and nodes
+// still on that line get its move at their ply as the priority move.
+
+namespace PVTable {
+    constexpr int MAX_PLY = MAX_DEPTH + 1;
+
+    struct Line {
+        std::array<Move, MAX_PLY> moves = {};
+        int len = 0;
+
+        std::string to_string() {
+            std::string s;
+            for (int i = 0; i < len; i++) {
+                s += (i ? " " : "") + moves[i].to_string();
+            }
+            return s;
+        }
+    };
+
+    // per-thread (every search thread builds its own lines).
+
+    thread_local Move table[MAX_PLY][MAX_PLY];
+    thread_local int len[MAX_PLY] = {};
+
+    thread_local Line prev;           // last completed iteration's pv
+    thread_local bool follow = false; // current node lies on prev
+
+    void clear_ply(U16 ply) {
+        len[ply] = 0;
+    }
+
+    // move beat alpha at ply: its line is move + the child's line.
+    void update(U16 ply, Move& move) {
+        table[ply][0] = move;
+        for (int i = 0; i < len[ply + 1]; i++) {
+            table[ply][i + 1] = table[ply + 1][i];
+        }
+        len[ply] = len[ply + 1] + 1;
+    }
+
+    Line root() {
+        Line line;
+        line.len = len[0];
+        for (int i = 0; i < line.len; i++) line.moves[i] = table[0][i];
+        return line;
+    }
+
+    // claims follow for this node, returns prev's move at ply (or Move()).
+    Move enter(U16 ply) {
+        bool on_pv = follow & (ply < prev.len);
+        follow = false;
+        return on_pv ? prev.moves[ply] : Move();
+    }
+
+    // the child stays on prev only through prev's own move.
+    void descend(Move& pv_move, Move& move) {
+        follow = pv_move.get_raw() && (pv_move.get_masked() == move.get_masked());
+    }
+
+    void clear() {
+        prev = Line();
+        follow = false;
+        for (int& l : len) l = 0;
+    }
+};
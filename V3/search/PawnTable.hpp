@@ -0,0 +1,109 @@
+#pragma once
+
+#include "../board/Board.hpp"
+#include "../util/data.hpp"
+
+#include <atomic>
+
+// Pawn-structure eval (passed, isolated & doubled pawns), white-relative
+// mg/eg terms to be tapered with PeSTO's. Pawns change on few moves, so
+// the terms are cached per thread by Context::pawn_key and a probe almost
+// always replaces the scan. Key 0 (no pawns) hits the zeroed table as-is.
+
+namespace PawnTable {
+    constexpr size_t SIZE = 1ULL << 16; // entries per thread (1 MB)
+
+    // by rank relative to the pawn's side (1 = home rank, 6 = 7th rank).
+    constexpr int PASSED_MG[8] = { 0, 0, 5, 10, 20, 35, 55, 0 };
+    constexpr int PASSED_EG[8] = { 0, 5, 10, 20, 35, 55, 80, 0 };
+    constexpr int ISOLATED_MG = -10, ISOLATED_EG = -12;
+    constexpr int DOUBLED_MG  = -10, DOUBLED_EG  = -25;
+
+    struct Entry {
+        U64 key;
+        I16 mg;
+        I16 eg;
+    };
+
+    // per-thread stats, summed into the totals by flush_stats().
+
+    thread_local U64 hits = 0;
+    thread_local U64 misses = 0;
+
+    std::atomic<U64> total_hits = 0;
+    std::atomic<U64> total_misses = 0;
+
+    thread_local Entry table[SIZE] = {};
+
+    // [color][sq]: squares in front of the pawn on its & the adjacent files.
+    U64 passed_masks[2][NUM_SQUARES];
+    U64 adjacent_files[8];
+
+    void init() {
+        for (int f = 0; f < 8; f++) {
+            adjacent_files[f] = (f > 0 ? BB_SETS::FILE[f - 1] : 0ULL)
+                              | (f < 7 ? BB_SETS::FILE[f + 1] : 0ULL);
+        }
+        for (int sq = 0; sq < NUM_SQUARES; sq++) {
+            int row = sq / 8, f = sq % 8;
+            U64 files = BB_SETS::FILE[f] | adjacent_files[f];
+            U64 above = row ? (~0ULL >> (8 * (8 - row))) : 0ULL; // rows < row
+            U64 below = row < 7 ? (~0ULL << (8 * (row + 1))) : 0ULL;
+            passed_masks[1][sq] = files & above; // white moves up (to row 0)
+            passed_masks[0][sq] = files & below;
+        }
+    }
+
+    template<class Color>
+    void eval_side(Board& b, int& mg, int& eg) {
+        constexpr bool turn = std::is_same<Color, White>::value;
+        U64 own = b.get_bitboard(Color::PAWN);
+        U64 opp = b.get_bitboard(Color::OPP_PAWN);
+
+        for (int f = 0; f < 8; f++) {
+            int cnt = pop_count(own & BB_SETS::FILE[f]);
+            if (cnt > 1) {
+                mg += DOUBLED_MG * (cnt - 1);
+                eg += DOUBLED_EG * (cnt - 1);
+            }
+        }
+
+        U64 pawns = own;
+        while (pawns) {
+            Square sq = pop_lsb(pawns);
+            int f = sq % 8;
+            int rank = turn ? 7 - sq / 8 : sq / 8;
+
+            if (!(own & adjacent_files[f])) {
+                mg += ISOLATED_MG;
+                eg += ISOLATED_EG;
+            }
+            if (!(opp & passed_masks[turn][sq])) {
+                mg += PASSED_MG[rank];
+                eg += PASSED_EG[rank];
+            }
+        }
+    }
+
+    Entry& probe(Board& b, U64 pawn_key) {
+        Entry& e = table[pawn_key & (SIZE - 1)];
+        if (e.key == pawn_key) {
+            hits++;
+            return e;
+        }
+        misses++;
+
+        int mg[2] = { 0, 0 }, eg[2] = { 0, 0 };
+        eval_side<White>(b, mg[1], eg[1]);
+        eval_side<Black>(b, mg[0], eg[0]);
+        e = { pawn_key, (I16)(mg[1] - mg[0]), (I16)(eg[1] - eg[0]) };
+        return e;
+    }
+
+    void flush_stats() {
+        total_hits += hits;
+        total_misses += misses;
+        hits = 0;
+        misses = 0;
+    }
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../util/types.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Long-lived search threads. Each "go" hands every worker the same job
+// (called with its thread id) through a condition variable, so threads and
+// their thread_local tables (killers, history, ...) survive across
+// iterations and moves instead of being rebuilt per search.
+
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::mutex mtx;
+    std::condition_variable job_cv;  // workers wait here for a new job
+    std::condition_variable done_cv; // wait() blocks here until all are idle
+
+    std::function<void(U16)> job;
+    U64  job_id   = 0;
+    U16  num_busy = 0;
+    bool quitting = false;
+
+    void worker_loop(U16 id, U64 seen_id) {
+        while (true) {
+            std::function<void(U16)> fn;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                job_cv.wait(lock, [&]() { return quitting || job_id != seen_id; });
+                if (quitting) return;
+                seen_id = job_id;
+                fn = job;
+            }
+
+            fn(id);
+
+            std::lock_guard<std::mutex> lock(mtx);
+            if (--num_busy == 0) done_cv.notify_all();
+        }
+    }
+
+public:
+    ThreadPool() {}
+
+    ~ThreadPool() {
+        resize(0);
+    }
+
+    U16 size() {
+        return (U16)workers.size();
+    }
+
+    // respawns the workers if the count changed (only between jobs).
+    void resize(U16 n) {
+        if (n == workers.size()) return;
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            quitting = true;
+        }
+        job_cv.notify_all();
+        for (std::thread& t : workers) t.join();
+        workers.clear();
+
+        quitting = false;
+        for (U16 id = 0; id < n; id++) {
+            workers.emplace_back(&ThreadPool::worker_loop, this, id, job_id);
+        }
+    }
+
+    // every worker runs fn(thread_id) once. returns immediately.
+    void start(std::function<void(U16)> fn) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            job = fn;
+            num_busy = (U16)workers.size();
+            job_id++;
+        }
+        job_cv.notify_all();
+    }
+
+    // blocks until every worker has finished the current job.
+    void wait() {
+        std::unique_lock<std::mutex> lock(mtx);
+        done_cv.wait(lock, [&]() { return num_busy == 0; });
+    }
+
+    // runs fn(thread_id) on every worker and waits for it.
+    void broadcast(std::function<void(U16)> fn) {
+        start(fn);
+        wait();
+    }
+};
@@ -2,6 +2,11 @@
 
 #include "../board/impl/index.hpp"
 #include "../init/pestos.hpp"
+#include "../init/nnue.hpp"
+#include "PawnTable.hpp"
+#include "MaterialTable.hpp"
+
+constexpr bool DEBUG_EVAL = false; // cross-check incremental eval vs. full scan
 
 namespace Evaluate {
     I16 piece_val(Board& b) {
@@ -17,7 +22,31 @@ namespace Evaluate {
         return eval;
     }
 
-    I16 pestos(Board& b) {
-        return PeSTOs::eval(b);
+    // PeSTO + pawn structure (one PawnTable probe) + material imbalance,
+    // tapered together.
+    I16 pestos(Board& b, Context& ctx, MaterialTable::Entry& mat) {
+        if constexpr (DEBUG_EVAL) {
+            assert("PESTO ACCUMULATORS", PeSTOs::eval(b) == PeSTOs::eval_full(b));
+        }
+        PawnTable::Entry& pawns = PawnTable::probe(b, ctx.pawn_key);
+        return (I16)PeSTOs::taper(
+            b.get_mg_score() + pawns.mg + mat.mg,
+            b.get_eg_score() + pawns.eg + mat.eg,
+            b.get_game_phase()
+        );
+    }
+
+    // clamped below mate scores: a net can't wrap I16 or fake a mate.
+    I16 nnue(Board& b) {
+        return (I16)std::clamp(NNUE::forward(b.get_accumulator()), 1 - (int)MATE_BOUND, (int)MATE_BOUND - 1);
+    }
+
+    // static eval (white-relative) from the selected backend, scaled down
+    // by the material table when the side ahead can't (easily) win.
+    I16 eval(Board& b, Context& ctx) {
+        MaterialTable::Entry& mat = MaterialTable::probe(ctx);
+        int eval = NNUE::active ? nnue(b) : pestos(b, ctx, mat);
+        int scale = mat.scale[eval > 0];
+        return (I16)(eval * scale / MaterialTable::SCALE_NORMAL);
     }
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../search.hpp"
+
+#include <chrono>
+
+// Fixed-depth search over a built-in position set. Every position starts
+// from a cleared TT & killers with no time limit, so with 1 thread the node
+// total is a signature that only moves when search behaviour does.
+
+namespace Search {
+    const std::string BENCH_FENS[] = {
+        "startpos",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+        "8/4r3/p3r3/P2bBkp1/1P6/2P3Pp/4R2P/4R1K1 w - - 7 49",
+        "8/8/3k4/8/2PK4/8/8/8 w - - 0 1"
+    };
+
+    void bench(U16 depth, U16 threads, size_t hash_mb) {
+        constexpr double NO_TIME_LIMIT = 1e6; // seconds on the clock
+
+        U16 prev_threads = num_threads;
+        size_t prev_mb = TranspositionTable::get_bytes() >> 20;
+        num_threads = (U16)std::clamp((int)threads, 1, (int)MAX_THREADS);
+        TranspositionTable::resize(hash_mb);
+
+        Board b;
+        U64 nodes = 0;
+        U64 tt_probes = 0, tt_hits = 0;
+        U64 eval_probes = 0, eval_hits = 0;
+        int hashfull = 0;
+        auto start = std::chrono::system_clock::now();
+
+        for (const std::string& fen : BENCH_FENS) {
+            clear();
+            bool turn;
+            Context ctx = b.from_fen(fen, turn);
+
+            U64 prev_nodes = total_negamax_nodes + total_quiesce_nodes;
+            U64 prev_hits = TranspositionTable::total_hits;
+            U64 prev_probes = prev_hits + TranspositionTable::total_misses;
+            U64 prev_eval_hits = EvalCache::total_hits + EvalCache::total_tt_hits;
+            U64 prev_eval_probes = prev_eval_hits + EvalCache::total_misses;
+            if (turn) search<White>(b, ctx, depth, NO_TIME_LIMIT);
+                 else search<Black>(b, ctx, depth, NO_TIME_LIMIT);
+            nodes += total_negamax_nodes + total_quiesce_nodes - prev_nodes;
+            tt_hits += TranspositionTable::total_hits - prev_hits;
+            tt_probes += TranspositionTable::total_hits + TranspositionTable::total_misses - prev_probes;
+            eval_hits += EvalCache::total_hits + EvalCache::total_tt_hits - prev_eval_hits;
+            eval_probes += EvalCache::total_hits + EvalCache::total_tt_hits + EvalCache::total_misses - prev_eval_probes;
+            hashfull += TranspositionTable::hashfull();
+        }
+
+        auto end = std::chrono::system_clock::now();
+        double t_sec = std::chrono::duration<double>(end - start).count();
+
+        std::cout << "bench depth " << depth << " threads " << num_threads
+                  << " hash " << hash_mb << "\n"
+                  << "nodes " << nodes << "\n"
+                  << "time " << t_sec << "\n"
+                  << "nps " << (U64)(nodes / t_sec) << "\n"
+                  << "tt hitrate " << (tt_hits + 0.0) / std::max(tt_probes, (U64)1) << "\n"
+                  << "eval hitrate " << (eval_hits + 0.0) / std::max(eval_probes, (U64)1) << "\n"
+                  << "hashfull " << hashfull / (int)std::size(BENCH_FENS) << "\n";
+        TranspositionTable::print_info(); // huge page / TLB coverage, table now touched
+
+        num_threads = prev_threads;
+        TranspositionTable::resize(prev_mb);
+        clear();
+    }
+};
@@ -2,4 +2,5 @@
 
 #include "nega_max.hpp"
 #include "quiesce.hpp"
-#include "timed_search.hpp"
\ No newline at end of file
+#include "timed_search.hpp"
+#include "bench.hpp"
\ No newline at end of file
@@ -2,59 +2,110 @@
 
 #include "../search.hpp"
 #include "../../board/TranspositionTable.hpp"
+#include "../../init/reductions.hpp"
+
+// Principal Variation Search: the first legal move gets the full window,
+// the rest are scouted with a null window and only re-searched (full
+// window) when the scout lands inside (alpha, beta).
+//
+// Nodes on the last iteration's pv try its move first, and every move
+// that beats alpha becomes the head of this ply's PVTable line.
+//
+// Late quiet moves (past the TT move, captures and killers) are scouted
+// at a reduced depth first, and only get the full-depth scout when the
+// reduced one fails high.
 
 template<class Color>
 MoveScore Search::nega_max(
     Board& b,
     Context& ctx,
     U16 depth,
+    U16 ply,
     I16 alpha,
     I16 beta
 ) {
     constexpr bool turn = std::is_same<Color, White>::value;
+    const bool is_pv = (beta - alpha) > 1;
     const I16 og_alpha = alpha;
     node_depth_hist[depth]++;
     negamax_nodes++;
+    if ((negamax_nodes & 1023) == 0) publish_nodes();
+
+    PVTable::clear_ply(ply);
+    Move pv_move = PVTable::enter(ply);
 
     if (stop_search) {
         return { Move(), 0 };
     }
 
-    if (DrawTable::is_draw()) {
+    if (ply > 0 && DrawTable::is_draw()) {
+        return { Move(), 0 };
+    }
+
+    // Insufficient material (MaterialTable::is_draw): neither side can force
+    // mate, whatever the depth. Drawish but winnable endings are searched.
+
+    if (ply > 0 && MaterialTable::probe(ctx).is_draw) {
+        material_draws++;
         return { Move(), 0 };
     }
 
     // Quiescence: at nega_max leaf.
 
     if (depth == 0) {
-        I16 score = quiesce<Color>(b, ctx, alpha, beta);
+        I16 score = quiesce<Color>(b, ctx, ply, alpha, beta);
         return { Move(), score };
     }
 
-    // TT-lookup: to adjust bounds and get priority move.
-
-    // auto [ tt_hit, tt_cell ] = TranspositionTable::get_cell(ctx.hash, depth);
-    // if (tt_hit & (tt_cell->get_depth() >= depth)) {
-    //     switch (tt_cell->node_type) {
-    //         case TranspositionTable::NodeType::EXACT: {
-    //             return { tt_cell->move, tt_cell->score };
-    //         }
-    //         case TranspositionTable::NodeType::LOWER: alpha = std::max(alpha, tt_cell->score);
-    //         case TranspositionTable::NodeType::UPPER: beta  = std::min(beta,  tt_cell->score);
-    //     }
-    //     if (alpha >= beta) {
-    //         KillerTable::add_move(turn, tt_cell->move, depth);
-    //         return { tt_cell->move, tt_cell->score };
-    //     }
-    // }
-    Move priority_move = Move();
+    // TT-lookup: cut off on depth-sufficient bounds (non-pv only, so the
+    // root and pv always get a real move), else use the move for ordering.
+
+    TranspositionTable::Record tt_rec;
+    auto [ tt_hit, tt_cell ] = TranspositionTable::get_cell(ctx.hash, ply, tt_rec);
+    if (tt_hit & !is_pv & (tt_rec.depth >= depth)) {
+        bool is_cutoff = (
+            (tt_rec.node_type == TranspositionTable::NodeType::EXACT)
+            | ((tt_rec.node_type == TranspositionTable::NodeType::LOWER) & (tt_rec.score >= beta))
+            | ((tt_rec.node_type == TranspositionTable::NodeType::UPPER) & (tt_rec.score <= alpha))
+        );
+        if (is_cutoff) {
+            return { tt_rec.move, tt_rec.score };
+        }
+    }
+    Move priority_move = pv_move.get_raw() ? pv_move : (tt_hit ? tt_rec.move : Move());
+
+    // Static Eval: shared by the pruning below (no stand-pat in check).
+    // The TT stores it with the score, else one eval cache probe.
+
+    const bool in_check = b.get_checks<Color>() != 0ULL;
+    const bool can_prune = !is_pv & !in_check & (std::abs(beta) < MATE_BOUND);
+    const bool has_tt_eval = tt_hit & (tt_rec.eval != TranspositionTable::NO_EVAL);
+    I16 static_eval = -INFINITY;
+    if (!in_check) {
+        static_eval = has_tt_eval ? tt_rec.eval : (turn ? 1 : -1) * EvalCache::eval(b, ctx);
+        EvalCache::tt_hits += has_tt_eval;
+    }
+
+    // Reverse Futility: too far above beta for the last plies to bring it back.
+
+    if (can_prune & (depth <= RFP_MAX_DEPTH) & (static_eval - rfp_margin * depth >= beta)) {
+        rfp_cutoffs++;
+        return { Move(), beta };
+    }
+
+    // Razoring: too far below alpha, let quiesce confirm there's no tactic.
+
+    if (can_prune & (depth <= RAZOR_MAX_DEPTH) & (static_eval + razor_margin * depth <= alpha)) {
+        I16 score = quiesce<Color>(b, ctx, ply, alpha, alpha + 1);
+        if (score <= alpha) {
+            razor_cutoffs++;
+            return { Move(), score };
+        }
+    }
 
     // Null-Move Heuristic
 
     if (depth >= NULL_DEPTH_REDUCTION) {
-        U64 no_checks = b.get_checks<Color>() == 0ULL;
-        I16 static_eval = (turn ? 1 : -1) * Evaluate::pestos(b);
-
         bool has_piece_req = (
             b.get_bitboard(Color::ALL) != (
                 b.get_bitboard(Color::PAWN)
@@ -63,7 +114,7 @@ MoveScore Search::nega_max(
         );
         bool has_static_req = static_eval > beta;
 
-        if (has_piece_req & no_checks & has_static_req) {
+        if (has_piece_req & !in_check & has_static_req) {
             int bound = (int)beta - (in_null_search ? 20 : 0);
             I16 b1 = (I16)std::clamp(-bound, -INFINITY, INFINITY);
             I16 b2 = (I16)std::clamp(1 - bound, -INFINITY, INFINITY);
@@ -74,9 +125,11 @@ MoveScore Search::nega_max(
             Context new_ctx = ctx;
             new_ctx.toggle_hash_turn();
             new_ctx.en_passant = 0;
+            TranspositionTable::prefetch(new_ctx.hash);
+            KillerTable::played[ply] = KillerTable::PieceTo();
             MoveScore null_best = (
-                turn ? nega_max<Black>(b, new_ctx, depth - NULL_DEPTH_REDUCTION, b1, b2)
-                     : nega_max<White>(b, new_ctx, depth - NULL_DEPTH_REDUCTION, b1, b2)
+                turn ? nega_max<Black>(b, new_ctx, depth - NULL_DEPTH_REDUCTION, ply + 1, b1, b2)
+                     : nega_max<White>(b, new_ctx, depth - NULL_DEPTH_REDUCTION, ply + 1, b1, b2)
             );
             null_best.score *= -1;
 
@@ -86,46 +139,104 @@ MoveScore Search::nega_max(
                 null_cutoffs++;
                 return { Move(), beta }; // eval after not moving
             }
-        }   
+        }
     }
 
     // Tests Moves.
 
-    MoveList ml;
-    b.gen_order_moves<Color, GenType::PSEUDOS>(ml, ctx, priority_move, depth);
+    MovePicker<Color, GenType::PSEUDOS> picker(b, ctx, priority_move, depth, ply);
 
     MoveScore best = { Move(), -INFINITY };
     I16 legal_move_count = 0;
+    const bool can_reduce = (depth >= LMR_MIN_DEPTH) & !in_check;
+    const bool is_futile = can_prune & (depth <= FUTILITY_MAX_DEPTH)
+                         & (static_eval + futility_margin * depth <= alpha);
+
+    for (Move move = picker.next(); move.get_raw(); move = picker.next()) {
+        bool is_quiet = (picker.get_stage() == Stage::QUIETS)
+                      & (move.get_flag() < Flag::KNIGHT_PROMO);
+        bool is_late_quiet = is_quiet & can_reduce & (legal_move_count >= LMR_MIN_MOVES);
+        bool no_capture = (move.get_capture() == Piece::NA)
+                        & (move.get_flag() < Flag::KNIGHT_PROMO);
+        Piece pc = b.get_board(move.get_from());
 
-    for (int i = 0; i < ml.size(); i++) {
         // do move
-        Move& move = ml[i];
         Context new_ctx = b.do_move<Color>(move, ctx);
+        TranspositionTable::prefetch(new_ctx.hash);
+        legal_move_count++;
+        bool gives_check = turn ? b.get_checks<Black>() : b.get_checks<White>();
 
-        // filter out illegal moves
-        if (b.get_checks<Color>()) { 
+        // futility: a quiet move can't make up the gap to alpha this close
+        // to the horizon (the first move is always searched for a score).
+        if (is_futile & is_quiet & !gives_check & (legal_move_count > 1)) {
             b.undo_move<Color>(move);
+            futility_prunes++;
             continue;
         }
-        legal_move_count++;
+        PVTable::descend(pv_move, move);
+        KillerTable::played[ply] = { pc, move.get_to() };
+
+        // determine local evaluation: full window for the first move,
+        // null-window scout + re-search for the rest.
+        MoveScore local_best;
+        if (legal_move_count == 1) {
+            local_best = (
+                turn ? nega_max<Black>(b, new_ctx, depth - 1, ply + 1, -beta, -alpha)
+                     : nega_max<White>(b, new_ctx, depth - 1, ply + 1, -beta, -alpha)
+            );
+            local_best.score *= -1;
+        } else {
+            I16 scout_beta = alpha + 1;
+
+            // reduce: quiet moves that don't give check, less so on the pv.
+            U16 r = 0;
+            if (is_late_quiet & !gives_check) {
+                int lmr = (int)REDUCTIONS::get(depth, legal_move_count) - is_pv;
+                r = (U16)std::clamp(lmr, 0, depth - 2);
+            }
+            if (r) {
+                lmr_searches++;
+                local_best = (
+                    turn ? nega_max<Black>(b, new_ctx, depth - 1 - r, ply + 1, -scout_beta, -alpha)
+                         : nega_max<White>(b, new_ctx, depth - 1 - r, ply + 1, -scout_beta, -alpha)
+                );
+                local_best.score *= -1;
+            }
 
-        // determine local evaluation
-        MoveScore local_best = (
-            turn ? nega_max<Black>(b, new_ctx, depth - 1, -beta, -alpha)
-                 : nega_max<White>(b, new_ctx, depth - 1, -beta, -alpha)
-        );
-        local_best.score *= -1;
+            if (!r || local_best.score > alpha) {
+                lmr_researches += r != 0;
+                local_best = (
+                    turn ? nega_max<Black>(b, new_ctx, depth - 1, ply + 1, -scout_beta, -alpha)
+                         : nega_max<White>(b, new_ctx, depth - 1, ply + 1, -scout_beta, -alpha)
+                );
+                local_best.score *= -1;
+            }
+
+            if ((local_best.score > alpha) & (local_best.score < beta)) {
+                local_best = (
+                    turn ? nega_max<Black>(b, new_ctx, depth - 1, ply + 1, -beta, -alpha)
+                         : nega_max<White>(b, new_ctx, depth - 1, ply + 1, -beta, -alpha)
+                );
+                local_best.score *= -1;
+            }
+        }
 
         // undo move
         b.undo_move<Color>(move);
 
         // use new evaluation
+        if (local_best.score > alpha) {
+            PVTable::update(ply, move);
+        }
         if ((best.move.get_raw() == 0) | (local_best.score > best.score)) {
             best = { move, local_best.score };
         }
         alpha = std::max(alpha, best.score);
         if (alpha >= beta) {
-            KillerTable::add_move(turn, move, depth);
+            KillerTable::add_move(move, depth);
+            if (no_capture) {
+                KillerTable::add_quiet_cutoff(turn, move, pc, depth, ply);
+            }
             break;
         }
     }
@@ -133,116 +244,18 @@ MoveScore Search::nega_max(
     // Checkmate or Stalemate.
 
     if (legal_move_count == 0) {
-        I16 score = b.get_checks<Color>() ? -INFINITY : 0;
-        return { Move(), score };
-    }
-
-    // TT-update: with new result.
-
-    // TranspositionTable::set_cell(
-    //     tt_cell, ctx.hash, depth,
-    //     best, og_alpha, beta
-    // );
-
-    return best;
-}
-
-template<class Color>
-MoveScore Search::nega_scout(
-    Board& b,
-    Context& ctx,
-    U16 depth,
-    I16 alpha,
-    I16 beta
-) {
-    constexpr bool turn = std::is_same<Color, White>::value;
-    I16 og_alpha = alpha;
-    I16 og_beta = beta;
-
-    if (DrawTable::is_draw()) {
-        return { Move(), 0 };
-    }
-
-    // TT-lookup: to adjust bounds and get priority move.
-
-    auto [ tt_hit, tt_cell ] = TranspositionTable::get_cell(ctx.hash, depth);
-    if (tt_hit && tt_cell->get_depth() >= depth) {
-        switch (tt_cell->node_type) {
-            case TranspositionTable::NodeType::EXACT: return { tt_cell->move, tt_cell->score };
-            case TranspositionTable::NodeType::LOWER: alpha = std::max(alpha, tt_cell->score);
-            case TranspositionTable::NodeType::UPPER: beta  = std::min(beta,  tt_cell->score);
-        }
-        if (alpha >= beta) return { tt_cell->move, tt_cell->score };
-    }
-    Move priority_move = tt_hit ? tt_cell->move : Move();
-
-    // Quiescence: at nega_max leaf.
-
-    if (depth == 0) {
-        I16 score = quiesce<Color>(b, ctx, alpha, beta);
-        return { Move(), score };
+        I16 score = in_check ? -MATE_SCORE + ply : 0;
+        best = { Move(), score };
     }
 
-    // Tests Moves.
-
-    MoveList ml;
-    b.gen_moves<Color, GenType::PSEUDOS>(ml, ctx, priority_move, depth);
-
-    MoveScore best = { Move(), -INFINITY };
-    I16 legal_move_count = 0;
-
-    for (int i = 0; i < ml.size(); i++) {
-        // do move
-        Move& move = ml[i];
-        Context new_ctx = b.do_move<Color>(move, ctx);
+    // TT-update: with new result (an interrupted search has no result).
 
-        // filter out illegal moves
-        if (b.get_checks<Color>()) { 
-            b.undo_move<Color>(move);
-            continue;
-        }
-        legal_move_count++;
-
-        // determine local evaluation
-        MoveScore local_best = (
-            turn ? nega_scout<Black>(b, new_ctx, depth - 1, -beta, -og_alpha)
-                 : nega_scout<White>(b, new_ctx, depth - 1, -beta, -og_alpha)
+    if (!stop_search) {
+        TranspositionTable::set_cell(
+            tt_cell, ctx.hash, depth, ply,
+            best, og_alpha, beta, static_eval
         );
-        local_best.score *= -1;
-
-        if ((local_best.score > alpha) & (local_best.score < og_beta) & (i > 0)) {
-            MoveScore local_best = (
-                turn ? nega_scout<Black>(b, new_ctx, depth - 1, -og_beta, -og_alpha)
-                    : nega_scout<White>(b, new_ctx, depth - 1, -og_beta, -og_alpha)
-            );
-            local_best.score *= -1;
-        }
-
-        // undo move
-        b.undo_move<Color>(move);
-
-        // use new evaluation
-        if ((best.move.get_raw() == 0) | (local_best.score > best.score)) {
-            best = { move, local_best.score };
-        }
-        og_alpha = std::max(og_alpha, best.score);
-        if (og_alpha >= og_beta) break;
-        beta = og_alpha + 1;
     }
 
-    // Checkmate or Stalemate.
-
-    if (legal_move_count == 0) {
-        I16 score = b.get_checks<Color>() ? -INFINITY : 0;
-        best = { Move(), score };
-    }
-
-    // TT-update: with new result.
-
-    TranspositionTable::set_cell(
-        tt_cell, ctx.hash, depth,
-        best, og_alpha, beta
-    );
-
     return best;
-}
\ No newline at end of file
+}
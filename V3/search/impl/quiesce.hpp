@@ -2,47 +2,74 @@
 
 #include "../search.hpp"
 
+// In check there is no stand-pat: every evasion is searched, and having
+// none is mate. Otherwise only good captures (SEE >= 0) are tried, minus
+// those that can't reach alpha even when the victim comes for free.
+
 template<class Color>
 I16 Search::quiesce(
     Board& b,
     Context& ctx,
+    U16 ply,
     I16 alpha,
     I16 beta
 ) {
     constexpr bool turn = std::is_same<Color, White>::value;
     quiesce_nodes++;
 
-    I16 eval = (I16)(turn ? 1 : -1) * Evaluate::pestos(b) + (turn ? 10 : -10);
-    
-    if (eval >= beta) return beta;
-    alpha = std::max(alpha, eval);
+    const bool in_check = b.get_checks<Color>() != 0ULL;
+    I16 eval = (I16)(turn ? 1 : -1) * EvalCache::eval(b, ctx) + (turn ? 10 : -10);
 
-    MoveList ml;
-    b.gen_order_moves<Color, GenType::CAPTURES>(ml, ctx);
-    if (ml.size() == 0) return eval;
+    // evasions can give check back, cap the chain.
+    if (ply >= MAX_QUIESCE_PLY) return eval;
 
-    for (int i = 0; i < ml.size(); i++) {
-        // do move
-        Move& move = ml[i];
+    auto search_move = [&](Move move) {
         Context new_ctx = b.do_move<Color>(move, ctx);
+        I16 local_eval = turn ? -quiesce<Black>(b, new_ctx, ply + 1, -beta, -alpha)
+                              : -quiesce<White>(b, new_ctx, ply + 1, -beta, -alpha);
+        b.undo_move<Color>(move);
+        return local_eval;
+    };
 
-        // filter out illegal moves
-        if (b.get_checks<Color>()) { 
-            b.undo_move<Color>(move);
-            continue;
+    // Check Evasions.
+
+    if (in_check) {
+        MovePicker<Color, GenType::PSEUDOS> picker(b, ctx);
+        Move move = picker.next();
+        if (!move.get_raw()) return -MATE_SCORE + ply;
+
+        for (; move.get_raw(); move = picker.next()) {
+            I16 local_eval = search_move(move);
+            if (local_eval >= beta) return beta;
+            alpha = std::max(alpha, local_eval);
         }
+        return alpha;
+    }
 
-        // evaluate after move
-        I16 local_eval = turn ? -quiesce<Black>(b, new_ctx, -beta, -alpha)
-                              : -quiesce<White>(b, new_ctx, -beta, -alpha);
+    // Stand-Pat.
 
-        // undo move
-        b.undo_move<Color>(move);
+    if (eval >= beta) return beta;
+    alpha = std::max(alpha, eval);
+
+    // Captures.
+
+    MovePicker<Color, GenType::CAPTURES> picker(b, ctx);
+
+    for (Move move = picker.next(); move.get_raw(); move = picker.next()) {
+        // losing captures (SEE < 0) come last, none of them are worth it.
+        if (picker.get_stage() == Stage::BAD_CAPTURES) break;
+
+        // delta pruning: promos can gain more than the victim, never pruned.
+        bool is_promo = move.get_flag() >= Flag::KNIGHT_PROMO;
+        int victim = move.get_flag() == Flag::EN_PASSANT
+                   ? SEE_VALS[(int)Piece::WHITE_PAWN]
+                   : SEE_VALS[(int)b.get_board(move.get_to())];
+        if (!is_promo && eval + victim + DELTA_MARGIN <= alpha) continue;
 
-        // use new evaluation
+        I16 local_eval = search_move(move);
         if (local_eval >= beta) return beta;
         alpha = std::max(alpha, local_eval);
     }
 
     return alpha;
-}
\ No newline at end of file
+}
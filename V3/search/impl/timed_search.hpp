@@ -3,8 +3,147 @@
 #include "../search.hpp"
 
 #include <chrono>
+#include <mutex>
+#include <condition_variable>
 #include <thread>
-#include <future>
+
+void Search::flush_stats() {
+    for (int i = 0; i < MAX_DEPTH; i++) {
+        total_node_depth_hist[i] += node_depth_hist[i];
+        node_depth_hist[i] = 0;
+    }
+    total_quiesce_nodes += quiesce_nodes;
+    total_negamax_nodes += negamax_nodes;
+    total_null_cutoffs  += null_cutoffs;
+    total_null_searches += null_searches;
+    total_lmr_searches   += lmr_searches;
+    total_lmr_researches += lmr_researches;
+    quiesce_nodes = negamax_nodes = null_cutoffs = null_searches = 0;
+    total_rfp_cutoffs     += rfp_cutoffs;
+    total_razor_cutoffs   += razor_cutoffs;
+    total_futility_prunes += futility_prunes;
+    total_material_draws  += material_draws;
+    lmr_searches = lmr_researches = 0;
+    rfp_cutoffs = razor_cutoffs = futility_prunes = material_draws = 0;
+
+    KillerTable::flush_stats();
+    TranspositionTable::flush_stats();
+    PawnTable::flush_stats();
+    MaterialTable::flush_stats();
+    EvalCache::flush_stats();
+}
+
+void Search::publish_nodes() {
+    thread_nodes[thread_slot].store(negamax_nodes + quiesce_nodes, std::memory_order_relaxed);
+}
+
+U64 Search::search_nodes() {
+    U64 nodes = 0;
+    for (int i = 0; i < num_threads; i++) {
+        nodes += thread_nodes[i].load(std::memory_order_relaxed);
+    }
+    return nodes;
+}
+
+void Search::clear() {
+    TranspositionTable::clear_cells();
+    EvalCache::clear();
+    KillerTable::clear_cells();
+    pool.broadcast([](U16) { KillerTable::clear_cells(); });
+}
+
+// uci score: centipawns, or "mate n" (in moves) beyond MATE_BOUND.
+
+std::string Search::score_to_string(I16 score) {
+    if (std::abs(score) < MATE_BOUND) return "cp " + std::to_string(score);
+    int plies = MATE_SCORE - std::abs(score);
+    int moves = (plies + 1) / 2;
+    return "mate " + std::to_string(score > 0 ? moves : -moves);
+}
+
+template<class Color>
+MoveScore Search::iterate(
+    Board& b,
+    Context& ctx,
+    U16 depth,
+    U16 thread_id,
+    double target_time
+) {
+    const bool is_main = thread_id == 0;
+    auto start_time = std::chrono::system_clock::now();
+
+    auto print_info = [&](int d, MoveScore& best) {
+        if (!is_main) return;
+        publish_nodes();
+        std::chrono::duration<double> used_time = std::chrono::system_clock::now() - start_time;
+        std::cout << "info depth " << d
+                  << " score " << score_to_string(best.score) // side to move's view
+                  << " nodes " << search_nodes()
+                  << " time " << (U64)(used_time.count() * 1000)
+                  << " hashfull " << TranspositionTable::hashfull()
+                  << " pv " << PVTable::prev.to_string() << "\n";
+    };
+
+    // initial search.
+
+    PVTable::clear();
+    MoveScore best = nega_max<Color>(b, ctx, 1, 0, -INFINITY, INFINITY);
+    PVTable::prev = PVTable::root();
+    print_info(1, best);
+    if (is_main) root_searched = true;
+
+    // iterative deepening: helpers skew their start depth so the threads
+    // spread over neighbouring depths and fill the shared TT for each other.
+
+    constexpr int INIT_ASPIRATION = 300;
+    int aspiration = INIT_ASPIRATION;
+    I16 guess = best.score; // window center, moved by failed iterations too
+
+    for (int d = 2 + (thread_id & 1); d <= depth;) {
+        if (std::abs(best.score) >= MATE_BOUND) break;
+        if (stop_search) break;
+
+        // Short circuit time: if already used 2/3 of time, can't afford next depth, just return current best to save time.
+
+        if (is_main) {
+            auto curr_time = std::chrono::system_clock::now();
+            std::chrono::duration<double> used_time = curr_time - start_time;
+            if (used_time.count() >= target_time * 0.67) break;
+        }
+
+        I16 alpha = (I16)std::max(guess - aspiration, -(int)INFINITY);
+        I16 beta  = (I16)std::min(guess + aspiration,  (int)INFINITY);
+        PVTable::follow = true;
+        MoveScore new_best = nega_max<Color>(b, ctx, d, 0, alpha, beta);
+
+        // an interrupted iteration is incomplete, keep the last full one.
+
+        if (stop_search) break;
+
+        bool aspiration_failed = (
+            (new_best.score <= alpha && alpha != -INFINITY)
+            || (new_best.score >= beta && beta != INFINITY)
+        );
+
+        // a failed window is incomplete too: best & prev stay the last full
+        // iteration's, so bestmove, pv & ponder always agree.
+        guess = new_best.score;
+        if (aspiration_failed) {
+            aspiration *= 8;
+            continue;
+        }
+
+        best = new_best;
+        PVTable::prev = PVTable::root();
+
+        print_info(d, best);
+
+        d++;
+        aspiration = INIT_ASPIRATION / d;
+    }
+
+    return best;
+}
 
 template<class Color>
 MoveScore Search::search(
@@ -14,85 +153,65 @@ MoveScore Search::search(
     double time_left,
     double increment
 ) {
-    constexpr bool turn = std::is_same<Color, White>::value;
-
     // estimate time to move.
 
     auto start_time = std::chrono::system_clock::now();
     constexpr double EXP_LATENCY = 0.1;
     constexpr double INC_USAGE = 0.8;
     constexpr double MOVE_OVERHEAD = 20.0;
+    constexpr double MIN_TARGET_TIME = 0.01;
     double target_time = (time_left / MOVE_OVERHEAD) + increment * INC_USAGE - EXP_LATENCY;
+    target_time = std::max(target_time, MIN_TARGET_TIME);
     std::cout << "info string search_time " << target_time << "\n";
     auto end_time = start_time + std::chrono::duration<double>(target_time);
 
-    // initial search.
+    // lazy smp: every thread searches its own copy of the position and
+    // draw history. only the transposition table is shared between them.
 
+    depth = std::min(depth, MAX_SEARCH_DEPTH);
+    pool.resize(num_threads);
+    TranspositionTable::new_search();
     Search::stop_search = false;
-    MoveScore best = nega_max<Color>(b, ctx, 1, -INFINITY, INFINITY);
-
-    // iterative deepening.
-
-    constexpr I16 INIT_ASPIRATION = 300;
-    I16 aspiration = INIT_ASPIRATION;
-
-    for (int d = 2; d <= depth;) {
-        if (best.score == INFINITY || best.score == -INFINITY) break;
-
-        // Short circuit time: if already used 2/3 of time, can't afford next depth, just return current best to save time.
-
-        auto curr_time = std::chrono::system_clock::now();
-        std::chrono::duration<double> used_time = curr_time - start_time;
-        if (used_time.count() >= target_time * 0.67) break;
-
-        // Create async thread
-
-        Search::stop_search = false;
-        std::future<MoveScore> fut = std::async(
-            std::launch::async,
-            nega_max<Color>,
-            std::ref(b),
-            std::ref(ctx),
-            d,
-            best.score - aspiration,
-            best.score + aspiration
-        );
-        std::future_status status = fut.wait_until(end_time);
-
-        // Get status of thread after wait_until.
-
-        switch (status) {
-            case std::future_status::timeout: {
-                Search::stop_search = true;
-                return best;
-            }
-            case std::future_status::ready: {
-                MoveScore new_best = fut.get();
-
-                bool aspiration_failed = (
-                    new_best.score <= best.score - aspiration
-                    || new_best.score >= best.score + aspiration
-                );
-
-                if (aspiration_failed) {
-                    best = new_best;
-                    aspiration *= 8;
-                    continue;
-                }
-
-                d++;
-                aspiration = INIT_ASPIRATION / d;
-                best = new_best;
-            }
+    Search::root_searched = false;
+    for (std::atomic<U64>& n : thread_nodes) n.store(0, std::memory_order_relaxed);
+    DrawTable::State draw_state = DrawTable::state;
+
+    std::mutex mtx;
+    std::condition_variable main_done_cv;
+    bool main_done = false;
+    MoveScore best;
+
+    auto run_thread = [&, b, ctx](U16 thread_id) mutable {
+        DrawTable::state = draw_state;
+        thread_slot = thread_id;
+
+        MoveScore res = iterate<Color>(b, ctx, depth, thread_id, target_time);
+        flush_stats();
+
+        if (thread_id == 0) {
+            std::lock_guard<std::mutex> lock(mtx);
+            best = res;
+            bool on_pv = (PVTable::prev.len > 1)
+                       && (PVTable::prev.moves[0].get_masked() == res.move.get_masked());
+            ponder_move = on_pv ? PVTable::prev.moves[1] : Move();
+            main_done = true;
+            main_done_cv.notify_one();
         }
+    };
+
+    pool.start(run_thread);
 
-        // print result
+    // wait for the main thread to finish its depth or for time to run out,
+    // then stop the helpers (likely mid-iteration at that point). depth 1 is
+    // never cut short: bestmove always comes from a completed iteration.
 
-        std::cout << "info depth " << d << "\n";
-        std::cout << "info score cp " << best.score * (turn ? 1 : -1) << "\n";
-        std::cout << "info pv " << best.move.to_string() << "\n";
-        
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        main_done_cv.wait_until(lock, end_time, [&]() { return main_done; });
     }
+    while (!Search::root_searched) std::this_thread::yield();
+    Search::stop_search = true;
 
+    pool.wait();
     return best;
-}
\ No newline at end of file
+}
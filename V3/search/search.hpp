@@ -3,11 +3,16 @@
 #include "../board/impl/index.hpp"
 #include "../move/impl/index.hpp"
 #include "evaluate.hpp"
+#include "EvalCache.hpp"
 #include "../board/TranspositionTable.hpp"
+#include "ThreadPool.hpp"
+#include "PVTable.hpp"
 #include <algorithm>
 #include <unordered_set>
 #include <atomic>
+#include <cmath>
 
+#undef INFINITY // <cmath>'s is a float
 #define INFINITY INT16_MAX
 
 namespace Search {
@@ -15,19 +20,76 @@ namespace Search {
     // constants
 
     constexpr U16 NULL_DEPTH_REDUCTION = 3;
+    constexpr U16 MAX_THREADS = 64;
+    constexpr U16 MAX_SEARCH_DEPTH = MAX_DEPTH - 1; // per-depth/ply tables hold MAX_DEPTH
+    constexpr U16 LMR_MIN_DEPTH = 3;
+    constexpr U16 LMR_MIN_MOVES = 3; // moves searched at full depth first
+    constexpr U16 RFP_MAX_DEPTH = 6;
+    constexpr U16 RAZOR_MAX_DEPTH = 2;
+    constexpr U16 FUTILITY_MAX_DEPTH = 2;
 
-    // stats
+    // pruning margins (cp per ply of depth left), set through setoption.
 
-    U64 node_depth_hist[MAX_DEPTH] = {};
-    U64 quiesce_nodes = 0;
-    U64 negamax_nodes = 0;
-    U64 null_cutoffs = 0;
-    U64 null_searches = 0;
+    int rfp_margin = 80;
+    int razor_margin = 250;
+    int futility_margin = 120;
+    constexpr U16 MAX_QUIESCE_PLY = 2 * MAX_DEPTH;
+    constexpr int DELTA_MARGIN = 200; // slack over the victim's value
+
+    // stats (per-thread, summed into the totals by flush_stats)
+
+    thread_local U64 node_depth_hist[MAX_DEPTH] = {};
+    thread_local U64 quiesce_nodes = 0;
+    thread_local U64 negamax_nodes = 0;
+    thread_local U64 null_cutoffs = 0;
+    thread_local U64 null_searches = 0;
+    thread_local U64 lmr_searches = 0;
+    thread_local U64 lmr_researches = 0;
+    thread_local U64 rfp_cutoffs = 0;
+    thread_local U64 razor_cutoffs = 0;
+    thread_local U64 futility_prunes = 0;
+    thread_local U64 material_draws = 0;
+
+    std::atomic<U64> total_node_depth_hist[MAX_DEPTH] = {};
+    std::atomic<U64> total_quiesce_nodes = 0;
+    std::atomic<U64> total_negamax_nodes = 0;
+    std::atomic<U64> total_null_cutoffs = 0;
+    std::atomic<U64> total_null_searches = 0;
+    std::atomic<U64> total_lmr_searches = 0;
+    std::atomic<U64> total_lmr_researches = 0;
+    std::atomic<U64> total_rfp_cutoffs = 0;
+    std::atomic<U64> total_razor_cutoffs = 0;
+    std::atomic<U64> total_futility_prunes = 0;
+    std::atomic<U64> total_material_draws = 0;
+
+    void flush_stats();
+
+    // live node counts for uci info: each thread publishes its own into its
+    // slot every few nodes, the main thread sums them (search_nodes).
+
+    std::atomic<U64> thread_nodes[MAX_THREADS] = {};
+    thread_local U16 thread_slot = 0;
+
+    void publish_nodes();
+    U64 search_nodes();
 
     // search
 
-    bool in_null_search = false;
-    std::atomic<bool> stop_search = false;
+    U16 num_threads = 1; // lazy smp: 1 main + (num_threads - 1) helpers.
+    ThreadPool pool;     // resized to num_threads on the next search.
+
+    thread_local bool in_null_search = false;
+    Move ponder_move; // 2nd move of the main thread's last pv (or none)
+    std::atomic<bool> stop_search = false; // shared, stops every thread.
+    std::atomic<bool> root_searched = false; // main thread finished depth 1
+
+    // new game: forget the TT and every thread's killers/history.
+
+    void clear();
+
+    // fixed position set -> node signature, time & nps (bench.hpp)
+
+    void bench(U16 depth, U16 threads, size_t hash_mb);
 
     template<class Color>
     static MoveScore search(
@@ -38,22 +100,27 @@ namespace Search {
         double increment = 0.0
     );
 
-    // mini-max searches
+    std::string score_to_string(I16 score);
+
+    // iterative deepening (one per search thread)
 
     template<class Color>
-    MoveScore nega_max(
+    MoveScore iterate(
         Board& b,
         Context& ctx,
         U16 depth,
-        I16 alpha,
-        I16 beta
+        U16 thread_id,
+        double target_time
     );
 
+    // mini-max searches
+
     template<class Color>
-    MoveScore nega_scout(
+    MoveScore nega_max(
         Board& b,
         Context& ctx,
         U16 depth,
+        U16 ply,
         I16 alpha,
         I16 beta
     );
@@ -62,6 +129,7 @@ namespace Search {
     I16 quiesce(
         Board& b,
         Context& ctx,
+        U16 ply,
         I16 alpha,
         I16 beta
     );
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../board/impl/index.hpp"
+#include "../move/impl/index.hpp"
+#include "../search/evaluate.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Evals/sec of each Evaluate backend over a perft-style walk, so the cost of
+// keeping the NNUE accumulator updated in do_move/undo_move is included.
+// Without a loaded network, a random one is used (throughput only).
+
+namespace EvalBench {
+    template<class Color>
+    I64 _walk(Board& b, Context& ctx, int depth, U64& evals) {
+        constexpr bool turn = std::is_same<Color, White>::value;
+
+        I64 sum = Evaluate::eval(b, ctx);
+        evals++;
+        if (depth == 0) return sum;
+
+        MoveList ml;
+        b.gen_moves<Color, GenType::LEGALS>(ml, ctx);
+        ml.fill_moves<Color, GenType::LEGALS>(&b);
+
+        for (int i = 0; i < ml.size(); i++) {
+            Context new_ctx = b.do_move<Color>(ml[i], ctx);
+            sum += turn ? _walk<Black>(b, new_ctx, depth - 1, evals)
+                        : _walk<White>(b, new_ctx, depth - 1, evals);
+            b.undo_move<Color>(ml[i]);
+        }
+        return sum;
+    }
+
+    double _run(std::vector<std::string>& fens, int depth, I64& checksum) {
+        Board b;
+        U64 evals = 0;
+        auto start = std::chrono::system_clock::now();
+        for (std::string& fen : fens) {
+            bool turn;
+            Context ctx = b.from_fen(fen, turn);
+            checksum += turn ? _walk<White>(b, ctx, depth, evals)
+                             : _walk<Black>(b, ctx, depth, evals);
+        }
+        auto end = std::chrono::system_clock::now();
+        std::chrono::duration<double> t_sec = end - start;
+        return evals / t_sec.count();
+    }
+
+    void run(std::vector<std::string> fens, int depth = 3) {
+        bool was_active = NNUE::active;
+        bool was_loaded = NNUE::loaded;
+        if (!was_loaded) NNUE::init_random(0x9E3779B97F4A7C15ULL);
+
+        I64 checksum = 0;
+        NNUE::active = false;
+        double pestos_eps = _run(fens, depth, checksum);
+        NNUE::active = true;
+        double nnue_eps = _run(fens, depth, checksum);
+        NNUE::active = was_active;
+        NNUE::loaded = was_loaded; // the random net must not be selectable
+
+#if defined(__AVX2__)
+        const char* kernel = "avx2";
+#else
+        const char* kernel = "scalar";
+#endif
+        std::cout << "pestos:\t" << pestos_eps << " evals/s\n"
+                  << "nnue:\t" << nnue_eps << " evals/s (" << kernel << ")\n"
+                  << "ratio:\t" << (pestos_eps / nnue_eps) << "x\n"
+                  << "(checksum " << checksum << ")\n";
+    }
+};
@@ -4,20 +4,81 @@
 #include "../move/impl/index.hpp"
 #include "../board/Context.hpp"
 #include "../util/conversion.hpp"
+#include "../search/ThreadPool.hpp"
+#include "../search/DrawTable.hpp"
+#include <atomic>
+#include <charconv>
 #include <unordered_map>
+#include <vector>
 #include <fstream>
+#include <sstream>
 #include <string>
 
 namespace Perft {
+    // count depth 1 as the number of legal moves instead of making them.
+
+    constexpr bool USE_BULK_COUNT = true;
+
+    // root moves are handed out to the pool one at a time, each thread
+    // walking its own copy of the board.
+
+    U16 num_threads = 1;
+    ThreadPool pool;
+    bool print_divide = false; // "move: count" per root move, like solution files
+
+    // perft hash: (key, depth) -> count, so transposed subtrees are only
+    // walked once. lockless like the TT: key is stored xor'ed with data.
+
+    struct HashEntry {
+        std::atomic<U64> key  = 0;
+        std::atomic<U64> data = 0; // [------COUNT------|DEPTH(8)]
+    };
+
+    HashEntry* hash_table = nullptr;
+    U64 hash_mask = 0;
+
+    U64 get_key(Context& ctx) {
+        return ctx.hash ^ ZOBRIST::en_passant_rands[ctx.en_passant];
+    }
+
+    bool probe(U64 key, int depth, U64& cnt) {
+        HashEntry& e = hash_table[key & hash_mask];
+        U64 data = e.data.load(std::memory_order_relaxed);
+        U64 stored_key = e.key.load(std::memory_order_relaxed) ^ data;
+        if ((stored_key != key) | ((int)(data & 0xFF) != depth)) return false;
+        cnt = data >> 8;
+        return true;
+    }
+
+    void store(U64 key, int depth, U64 cnt) {
+        HashEntry& e = hash_table[key & hash_mask];
+        U64 data = (cnt << 8) | (U64)depth;
+        e.key.store(key ^ data, std::memory_order_relaxed);
+        e.data.store(data, std::memory_order_relaxed);
+    }
+
+    // mb = 0 frees the table (hashing off).
+    void resize_hash(U64 mb) {
+        delete[] hash_table;
+        hash_table = nullptr;
+        hash_mask = 0;
+        if (mb == 0) return;
+
+        U64 n = 1;
+        while (n * 2 * sizeof(HashEntry) <= (mb << 20)) n *= 2;
+        hash_table = new HashEntry[n];
+        hash_mask = n - 1;
+    }
+
     struct Stats {
         int flag_hist[14] = {};
-        int move_hist[64 * 64 * 8] = {};
+        U64 move_hist[64 * 64 * 8] = {};
         int checks = 0;
         int checkmates = 0;
         int init_depth;
 
-        void add_move(Move m, int res) {
-            int sq = (m.get_raw() >> 4) & 0b111111111111;
+        void add_move(Move m, U64 res) {
+            int sq = ((int)m.get_from() << 6) | (int)m.get_to();
             if (m.get_flag() >= Flag::KNIGHT_PROMO) {
                 int promo_pc = (int)m.get_flag() - 2;
                 sq |= promo_pc << 12;
@@ -28,13 +89,13 @@ namespace Perft {
 
     void read_solution_file(
         std::string fname,
-        std::unordered_map<std::string, int> &solution_hist,
+        std::unordered_map<std::string, U64> &solution_hist,
         bool CMP_TO_SOLUTION
     ) {
         if (!CMP_TO_SOLUTION) return;
 
         std::ifstream infile(fname);
-        std::string move; int cnt;
+        std::string move; U64 cnt;
         while (infile >> move >> cnt) {
             solution_hist.insert({move, cnt});
         }
@@ -42,13 +103,13 @@ namespace Perft {
 
     void print_hist_output(
         Stats &stats,
-        std::unordered_map<std::string, int> &solution_hist,
+        std::unordered_map<std::string, U64> &solution_hist,
         bool CMP_TO_SOLUTION
     ) {
-        std::unordered_map<std::string, int> my_hist;
+        std::unordered_map<std::string, U64> my_hist;
 
         for (int i = 0; i < 64 * 64 * 8; i++) {
-            int cnt = stats.move_hist[i];
+            U64 cnt = stats.move_hist[i];
             if (cnt == 0) continue;
 
             std::string str = square_num_to_string((i >> 6) & 0b111111)
@@ -58,6 +119,7 @@ namespace Perft {
             str += ":";
 
             my_hist[str] = cnt;
+            if (print_divide) std::cout << str << " " << cnt << "\n";
 
             if (CMP_TO_SOLUTION) {
                 if (solution_hist.find(str) == solution_hist.end()) {
@@ -95,45 +157,96 @@ namespace Perft {
             return 1;
         }
 
+        U64 key = 0;
+        if (hash_table && depth >= 2) {
+            U64 cnt;
+            key = get_key(ctx);
+            if (probe(key, depth, cnt)) return cnt;
+        }
+
         MoveList ml;
-        b.gen_moves<Color, GenType::PSEUDOS>(ml, ctx);
-        ml.fill_moves<Color, GenType::PSEUDOS>(&b);
+        b.gen_moves<Color, GenType::LEGALS>(ml, ctx);
+
+        if constexpr (USE_BULK_COUNT) {
+            if (depth == 1) return ml.size();
+        }
+
+        ml.fill_moves<Color, GenType::LEGALS>(&b);
 
         U64 cnt = 0;
         for (int i = 0; i < ml.size(); i++) {
             Context new_ctx = b.do_move<Color>(ml[i], ctx);
 
-            if (b.get_checks<Color>() == 0ULL) { // filter out illegal moves
-                U64 res = turn ? _run<Black>(b, new_ctx, depth - 1, stats)
-                               : _run<White>(b, new_ctx, depth - 1, stats);
-                // if (depth == stats.init_depth) stats.add_move(ml[i], res);
-                cnt += res;
-            }
+            U64 res = turn ? _run<Black>(b, new_ctx, depth - 1, stats)
+                           : _run<White>(b, new_ctx, depth - 1, stats);
+            // if (depth == stats.init_depth) stats.add_move(ml[i], res);
+            cnt += res;
 
             b.undo_move<Color>(ml[i]);
         }
 
+        if (hash_table && depth >= 2) store(key, depth, cnt);
+
         // stats.checkmates += cnt == 0; // no legal moves == checkmate.
         return cnt;
     }
 
     template<class Color>
-    void run(Board& b, Context& ctx, int depth, std::string solution_file = "") {
+    U64 _run_root(Board& b, Context& ctx, int depth, Stats& stats) {
+        constexpr bool turn = std::is_same<Color, White>::value;
+        if (depth == 0) return 1;
+
+        MoveList ml;
+        b.gen_moves<Color, GenType::LEGALS>(ml, ctx);
+        ml.fill_moves<Color, GenType::LEGALS>(&b);
+
+        std::vector<U64> counts(ml.size());
+        std::atomic<int> next = 0;
+
+        // do_move / undo_move push & pop the thread_local draw history, so
+        // seed every worker's with the caller's, as Search::search does.
+        DrawTable::State draw_state = DrawTable::state;
+
+        pool.resize(num_threads);
+        pool.broadcast([&](U16) {
+            DrawTable::state = draw_state;
+            Board local_b = b;
+            Stats local_stats;
+            for (int i = next++; i < ml.size(); i = next++) {
+                Context new_ctx = local_b.do_move<Color>(ml[i], ctx);
+                counts[i] = turn ? _run<Black>(local_b, new_ctx, depth - 1, local_stats)
+                                 : _run<White>(local_b, new_ctx, depth - 1, local_stats);
+                local_b.undo_move<Color>(ml[i]);
+            }
+        });
+
+        U64 cnt = 0;
+        for (int i = 0; i < ml.size(); i++) {
+            stats.add_move(ml[i], counts[i]);
+            cnt += counts[i];
+        }
+        return cnt;
+    }
+
+    template<class Color>
+    void run(Board& b, Context& ctx, int depth, std::string solution_file = "", U64 hash_mb = 0) {
         constexpr bool turn = std::is_same<Color, White>::value;
 
         bool CMP_TO_SOLUTION = solution_file.size() != 0;
-        std::unordered_map<std::string, int> solution_hist;
+        std::unordered_map<std::string, U64> solution_hist;
         read_solution_file(solution_file, solution_hist, CMP_TO_SOLUTION);
 
         Stats stats; stats.init_depth = depth;
+        resize_hash(hash_mb); // a fresh table per run, so timings compare
 
         auto start = std::chrono::system_clock::now();
-        U64 res = _run<Color>(b, ctx, depth, stats);
+        U64 res = _run_root<Color>(b, ctx, depth, stats);
         auto end = std::chrono::system_clock::now();
         std::chrono::duration<double> t_sec = end - start;
         // std::cout << "PERFT " << depth << ": " << res << "\n\n";
         std::cout << t_sec.count() << " s\n";
-        std::cout << (res / t_sec.count()) << " n/s\n";
+        std::cout << (res / t_sec.count()) << " n/s" << (hash_mb ? " (hashed)" : "")
+                  << " threads " << num_threads << "\n";
 
         // std::cout << "CHECKS: " << stats.checks << '\n'; 
         // std::cout << "CHECKMATE: " << stats.checkmates << "\n\n";
@@ -145,4 +258,83 @@ namespace Perft {
 
         std::cout << "Nodes searched: " << res << '\n';    
     }
-};
\ No newline at end of file
+
+    // EPD suite: one position per line, "fen ;D1 n ;D2 n ...". every listed
+    // depth <= max_depth is checked, with one machine-readable line each:
+    //      perft pos <i> depth <d> nodes <n> expected <n> time <s> nps <n> ok|FAIL
+    // then a "suite ..." summary. returns false on any mismatch.
+
+    // ";D<n>" -> n (1..MAX_DEPTH), 0 for anything else.
+    int parse_depth_tag(std::string& tag) {
+        if (tag.size() < 3 || tag[0] != ';' || tag[1] != 'D') return 0;
+        int depth = 0;
+        const char* end = tag.data() + tag.size();
+        auto [ ptr, ec ] = std::from_chars(tag.data() + 2, end, depth);
+        bool ok = (ec == std::errc()) & (ptr == end) & (depth >= 1) & (depth <= MAX_DEPTH);
+        return ok ? depth : 0;
+    }
+
+    U64 nps(U64 nodes, double t_sec) {
+        return t_sec > 0.0 ? (U64)(nodes / t_sec) : 0;
+    }
+
+    bool run_suite(std::string fname, int max_depth, U64 hash_mb = 0) {
+        std::ifstream infile(fname);
+        if (!infile) {
+            std::cout << "info string can't open " << fname << "\n";
+            return false;
+        }
+
+        resize_hash(hash_mb);
+        Board b;
+        U64 total_nodes = 0, checks = 0, failed = 0;
+        double total_time = 0.0;
+        int pos = 0;
+
+        std::string line;
+        while (std::getline(infile, line)) {
+            size_t semi = line.find(';');
+            if (line.empty() || line[0] == '#' || semi == std::string::npos) continue;
+            pos++;
+
+            std::string fen = line.substr(0, semi);
+            std::stringstream ss(line.substr(semi));
+            std::string tag; U64 expected;
+            while (ss >> tag >> expected) {
+                int depth = parse_depth_tag(tag);
+                if (depth == 0) {
+                    std::cout << "info string pos " << pos << ": skipping opcode " << tag << "\n";
+                    continue;
+                }
+                if (depth > max_depth) continue;
+
+                bool turn;
+                Context ctx = b.from_fen(fen, turn);
+                Stats stats; stats.init_depth = depth;
+
+                auto start = std::chrono::system_clock::now();
+                U64 nodes = turn ? _run_root<White>(b, ctx, depth, stats)
+                                 : _run_root<Black>(b, ctx, depth, stats);
+                auto end = std::chrono::system_clock::now();
+                double t = std::chrono::duration<double>(end - start).count();
+
+                bool ok = nodes == expected;
+                checks++;
+                failed += !ok;
+                total_nodes += nodes;
+                total_time += t;
+
+                std::cout << "perft pos " << pos << " depth " << depth
+                          << " nodes " << nodes << " expected " << expected
+                          << " time " << t << " nps " << nps(nodes, t)
+                          << (ok ? " ok" : " FAIL") << "\n";
+            }
+        }
+
+        std::cout << "suite positions " << pos << " checks " << checks
+                  << " failed " << failed << " nodes " << total_nodes
+                  << " time " << total_time << " nps " << nps(total_nodes, total_time)
+                  << " threads " << num_threads << " hash " << hash_mb << "\n";
+        return failed == 0;
+    }
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../board/TranspositionTable.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Hammers a handful of TT entries from many threads at once. Every record
+// stored is a pure function of its hash, so any hit that doesn't match that
+// function is a torn/corrupted read.
+
+namespace TTStress {
+    constexpr int POOL_SIZE = 4096; // keys shared by all threads
+    constexpr int NUM_SLOTS = 64;   // entries they all collide on
+
+    U64 next_rand(U64& x) { // xorshift64
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        return x;
+    }
+
+    MoveScore expected(U64 hash) {
+        Move move = Move((U32)(hash >> 23) & Move::MOVE_MASK);
+        I16 score = (I16)((hash >> 44) % 20000) - 10000;
+        return { move, score };
+    }
+
+    U16 expected_depth(U64 hash) {
+        return (U16)((hash >> 58) + 1);
+    }
+
+    void run(int num_threads = 16, U64 iters = 1ULL << 22) {
+        TranspositionTable::clear_cells();
+
+        std::vector<U64> pool(POOL_SIZE);
+        U64 seed = 0x9E3779B97F4A7C15ULL;
+        for (U64& key : pool) {
+            key = (next_rand(seed) & ~TranspositionTable::idx_mask)
+                | (next_rand(seed) % NUM_SLOTS);
+        }
+
+        std::atomic<U64> hits = 0, misses = 0, corrupted = 0;
+
+        auto worker = [&](int id) {
+            U64 rng = seed ^ (id + 1) * 0xBF58476D1CE4E5B9ULL;
+            U64 local_hits = 0, local_misses = 0, local_corrupted = 0;
+
+            for (U64 i = 0; i < iters; i++) {
+                U64 hash = pool[next_rand(rng) % POOL_SIZE];
+                MoveScore ms = expected(hash);
+                U16 depth = expected_depth(hash);
+
+                TranspositionTable::Record rec;
+                auto [ hit, cell ] = TranspositionTable::get_cell(hash, 0, rec);
+
+                if (hit) {
+                    local_hits++;
+                    bool ok = (rec.move.get_raw() == ms.move.get_raw())
+                           & (rec.score == ms.score)
+                           & (rec.depth == depth)
+                           & (rec.node_type == TranspositionTable::NodeType::EXACT);
+                    local_corrupted += !ok;
+                } else {
+                    local_misses++;
+                }
+
+                TranspositionTable::set_cell(cell, hash, depth, 0, ms, -INT16_MAX, INT16_MAX);
+            }
+
+            hits += local_hits;
+            misses += local_misses;
+            corrupted += local_corrupted;
+        };
+
+        auto start = std::chrono::system_clock::now();
+        std::vector<std::thread> threads;
+        for (int id = 0; id < num_threads; id++) threads.emplace_back(worker, id);
+        for (std::thread& t : threads) t.join();
+        auto end = std::chrono::system_clock::now();
+        std::chrono::duration<double> t_sec = end - start;
+
+        std::cout << "threads:\t" << num_threads << "\n"
+                  << "probes:\t\t" << (hits + misses) << "\n"
+                  << "hits:\t\t" << hits << "\n"
+                  << "corrupted:\t" << corrupted << "\n"
+                  << (num_threads * iters / t_sec.count()) << " probes/s\n";
+
+        TranspositionTable::clear_cells();
+    }
+};